@@ -0,0 +1,173 @@
+//------------------------------------------------------------------------
+//  Bitboard helpers and precomputed attack tables - The slider tables,
+//  which are too big and slow to build at compile time.
+//------------------------------------------------------------------------
+
+#include "ChessBitboard.h"
+
+#if defined(CHESS_HAS_PEXT) && !defined(_MSC_VER)
+#include <cpuid.h>
+#endif
+
+//--------------------------------------------------------------------------------------------------
+
+namespace
+{
+	//xorshift64* - Fixed seeds, so the same magics come out on every run.
+	class MagicRandom
+	{
+	public:
+		explicit MagicRandom(uint64_t seed) : mState(seed) {}
+
+		uint64_t Next()
+		{
+			mState ^= mState >> 12;
+			mState ^= mState << 25;
+			mState ^= mState >> 27;
+			return mState * 2685821657736338717ULL;
+		}
+
+		//Magics with few bits set are found much sooner.
+		uint64_t NextSparse()	{ return Next() & Next() & Next(); }
+
+	private:
+		uint64_t mState;
+	};
+
+	//----------------------------------------------------------------------------------------------
+
+	//PEXT is in every CPU with BMI2, but before Zen 3 AMD ran it in microcode, slower than a
+	//multiply.
+	bool HasFastPext()
+	{
+#ifdef CHESS_HAS_PEXT
+		unsigned int registers[4][4] = {};
+		auto cpuid = [&](unsigned int leaf, unsigned int* out)
+		{
+#ifdef _MSC_VER
+			__cpuidex((int*)out, (int)leaf, 0);
+#else
+			__cpuid_count(leaf, 0, out[0], out[1], out[2], out[3]);
+#endif
+		};
+
+		cpuid(0, registers[0]);
+		if(registers[0][0] < 7)
+			return false;
+
+		cpuid(1, registers[1]);
+		cpuid(7, registers[2]);
+		if(!(registers[2][1] & (1 << 8)))
+			return false;
+
+		//"AuthenticAMD" is split across EBX, EDX and ECX.
+		bool isAMD = registers[0][1] == 0x68747541 && registers[0][3] == 0x69746E65 && registers[0][2] == 0x444D4163;
+		unsigned int family = (registers[1][0] >> 8) & 0xF;
+		if(family == 0xF)
+			family += (registers[1][0] >> 20) & 0xFF;
+
+		return !isAMD || family >= 0x19;
+#else
+		return false;
+#endif
+	}
+
+	//----------------------------------------------------------------------------------------------
+
+	//Fills in each square's mask, magic and slots, packing the squares one after another in attacks.
+	void InitSliders(const RAY_DIRECTION (&directions)[4], bool usePext, SliderMagic* magics, Bitboard* attacks)
+	{
+		//Seeds that find every square's magic after few tries, by rank.
+		const uint64_t kSeeds[8] = { 728, 10316, 55341, 32803, 12281, 15100, 16645, 255 };
+
+		Bitboard occupancies[4096];
+		Bitboard references[4096];
+		int		 tried[4096] = {};
+		int		 attempt	 = 0;
+		Bitboard* nextSlot	 = attacks;
+
+		for(int square = 0; square < 64; square++)
+		{
+			SliderMagic& magic = magics[square];
+
+			//A blocker on the edge hides nothing, so the edge squares not on this square's own rank
+			//or file are left out of the mask.
+			Bitboard edges = ((kRank1Bitboard | kRank8Bitboard) & ~(kRank1Bitboard << (RankOfSquare(square) * 8))) |
+							 ((kFileABitboard | kFileHBitboard) & ~(kFileABitboard << FileOfSquare(square)));
+
+			magic.mask = 0;
+			for(RAY_DIRECTION direction : directions)
+				magic.mask |= kAttackTables.rays[direction][square];
+			magic.mask	 &= ~edges;
+			magic.shift	  = 64 - CountBits(magic.mask);
+			magic.magic	  = 0;
+			magic.attacks = nextSlot;
+
+			Bitboard* slots = nextSlot;
+
+			//Walk every subset of the mask and work out its attacks the slow way, along the rays.
+			int		 count	  = 0;
+			Bitboard occupied = 0;
+			do
+			{
+				occupancies[count] = occupied;
+				references[count]  = 0;
+				for(RAY_DIRECTION direction : directions)
+					references[count] |= RayAttacks(direction, square, occupied);
+
+#ifdef CHESS_HAS_PEXT
+				if(usePext)
+					slots[ParallelBitExtract(occupied, magic.mask)] = references[count];
+#endif
+				count++;
+				occupied = (occupied - magic.mask) & magic.mask;
+			}
+			while(occupied);
+
+			nextSlot += count;
+			if(usePext)
+				continue;
+
+			//Try random magics until one sends every subset to a slot that is either unused or
+			//already holds the same attacks.
+			MagicRandom random(kSeeds[RankOfSquare(square)]);
+			for(int index = 0; index < count;)
+			{
+				do
+					magic.magic = random.NextSparse();
+				while(CountBits((magic.magic * magic.mask) >> 56) < 6);
+
+				attempt++;
+				for(index = 0; index < count; index++)
+				{
+					unsigned slot = (unsigned)(((occupancies[index] & magic.mask) * magic.magic) >> magic.shift);
+					if(tried[slot] < attempt)
+					{
+						tried[slot] = attempt;
+						slots[slot] = references[index];
+					}
+					else if(slots[slot] != references[index])
+					{
+						break;
+					}
+				}
+			}
+		}
+	}
+}
+
+//--------------------------------------------------------------------------------------------------
+
+const SliderTables kSliderTables;
+
+SliderTables::SliderTables()
+{
+	const RAY_DIRECTION kRookDirections[4]	 = { RAY_NORTH, RAY_EAST, RAY_SOUTH, RAY_WEST };
+	const RAY_DIRECTION kBishopDirections[4] = { RAY_NORTH_EAST, RAY_NORTH_WEST, RAY_SOUTH_EAST, RAY_SOUTH_WEST };
+
+	usePext = HasFastPext();
+	InitSliders(kRookDirections, usePext, rook, rookAttacks);
+	InitSliders(kBishopDirections, usePext, bishop, bishopAttacks);
+}
+
+//--------------------------------------------------------------------------------------------------
@@ -0,0 +1,294 @@
+//------------------------------------------------------------------------
+//  Bitboard helpers and precomputed attack tables.
+//------------------------------------------------------------------------
+
+#ifndef _CHESS_BITBOARD_H
+#define _CHESS_BITBOARD_H
+
+#include "ChessCommons.h"
+#include <bit>
+#include <cstdint>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+//--------------------------------------------------------------------------------------------------
+//          Square indexing
+// Bitboards use the conventional a1 = 0 ... h8 = 63 layout. The Board structure stores [x][y]
+// with y = 0 being BLACK's back rank, so rank = 7 - y.
+//--------------------------------------------------------------------------------------------------
+
+typedef uint64_t Bitboard;
+
+const int kNoSquare = -1;
+
+const int kSquareA1 = 0;
+const int kSquareC1 = 2;
+const int kSquareD1 = 3;
+const int kSquareE1 = 4;
+const int kSquareF1 = 5;
+const int kSquareG1 = 6;
+const int kSquareH1 = 7;
+const int kSquareA8 = 56;
+const int kSquareC8 = 58;
+const int kSquareD8 = 59;
+const int kSquareE8 = 60;
+const int kSquareF8 = 61;
+const int kSquareG8 = 62;
+const int kSquareH8 = 63;
+
+const Bitboard kFileABitboard = 0x0101010101010101ULL;
+const Bitboard kFileHBitboard = kFileABitboard << 7;
+const Bitboard kRank1Bitboard = 0x00000000000000FFULL;
+const Bitboard kRank8Bitboard = kRank1Bitboard << 56;
+
+//--------------------------------------------------------------------------------------------------
+
+inline int		 SquareFromBoardPosition(int x, int y)	{ return (7 - y) * 8 + x; }
+inline int		 BoardXFromSquare(int square)			{ return square & 7; }
+inline int		 BoardYFromSquare(int square)			{ return 7 - (square >> 3); }
+inline int		 FileOfSquare(int square)				{ return square & 7; }
+inline int		 RankOfSquare(int square)				{ return square >> 3; }
+
+inline Bitboard  SquareBitboard(int square)				{ return 1ULL << square; }
+inline int		 CountBits(Bitboard bitboard)			{ return std::popcount(bitboard); }
+inline int		 LowestBit(Bitboard bitboard)			{ return std::countr_zero(bitboard); }
+inline int		 HighestBit(Bitboard bitboard)			{ return 63 - std::countl_zero(bitboard); }
+
+//Returns the lowest set square and clears it - The core of all set-bit iteration.
+inline int PopLowestBit(Bitboard* bitboard)
+{
+	int square = std::countr_zero(*bitboard);
+	*bitboard &= *bitboard - 1;
+	return square;
+}
+
+inline COLOUR OppositeColour(COLOUR colour)
+{
+	return colour == COLOUR_WHITE ? COLOUR_BLACK : COLOUR_WHITE;
+}
+
+//--------------------------------------------------------------------------------------------------
+//          Attack tables
+// Step attacks (pawn, knight, king) are looked up directly. Rays run from a square to the edge in
+// one direction, and are what the slider tables below are built from.
+//--------------------------------------------------------------------------------------------------
+
+enum RAY_DIRECTION
+{
+	RAY_NORTH,
+	RAY_NORTH_EAST,
+	RAY_EAST,
+	RAY_NORTH_WEST,
+
+	//Directions below here run towards lower square indices.
+	RAY_SOUTH,
+	RAY_SOUTH_WEST,
+	RAY_WEST,
+	RAY_SOUTH_EAST,
+
+	RAY_DIRECTION_COUNT
+};
+
+struct AttackTables
+{
+	Bitboard knight[64];
+	Bitboard king[64];
+	Bitboard pawn[2][64];		//[COLOUR][square] - Squares a pawn of that colour attacks.
+	Bitboard rays[RAY_DIRECTION_COUNT][64];
+	Bitboard lines[64][64];		//[from][to] - Edge to edge through both squares, if they share a line.
+};
+
+constexpr AttackTables GenerateAttackTables()
+{
+	AttackTables tables = {};
+
+	const int knightFiles[8] = { 1, 2, 2, 1, -1, -2, -2, -1 };
+	const int knightRanks[8] = { 2, 1, -1, -2, -2, -1, 1, 2 };
+	const int rayFiles[RAY_DIRECTION_COUNT] = { 0, 1, 1, -1, 0, -1, -1, 1 };
+	const int rayRanks[RAY_DIRECTION_COUNT] = { 1, 1, 0, 1, -1, -1, 0, -1 };
+
+	for(int square = 0; square < 64; square++)
+	{
+		int file = square & 7;
+		int rank = square >> 3;
+
+		for(int i = 0; i < 8; i++)
+		{
+			int toFile = file + knightFiles[i];
+			int toRank = rank + knightRanks[i];
+			if(toFile >= 0 && toFile < 8 && toRank >= 0 && toRank < 8)
+				tables.knight[square] |= 1ULL << (toRank * 8 + toFile);
+		}
+
+		for(int rankStep = -1; rankStep <= 1; rankStep++)
+		{
+			for(int fileStep = -1; fileStep <= 1; fileStep++)
+			{
+				int toFile = file + fileStep;
+				int toRank = rank + rankStep;
+				if((fileStep != 0 || rankStep != 0) && toFile >= 0 && toFile < 8 && toRank >= 0 && toRank < 8)
+					tables.king[square] |= 1ULL << (toRank * 8 + toFile);
+			}
+		}
+
+		for(int fileStep = -1; fileStep <= 1; fileStep += 2)
+		{
+			int toFile = file + fileStep;
+			if(toFile < 0 || toFile >= 8)
+				continue;
+
+			if(rank < 7)
+				tables.pawn[COLOUR_WHITE][square] |= 1ULL << ((rank + 1) * 8 + toFile);
+			if(rank > 0)
+				tables.pawn[COLOUR_BLACK][square] |= 1ULL << ((rank - 1) * 8 + toFile);
+		}
+
+		for(int direction = 0; direction < RAY_DIRECTION_COUNT; direction++)
+		{
+			int toFile = file + rayFiles[direction];
+			int toRank = rank + rayRanks[direction];
+			while(toFile >= 0 && toFile < 8 && toRank >= 0 && toRank < 8)
+			{
+				tables.rays[direction][square] |= 1ULL << (toRank * 8 + toFile);
+				toFile += rayFiles[direction];
+				toRank += rayRanks[direction];
+			}
+		}
+	}
+
+	//Each direction and the one four further on are opposites.
+	for(int square = 0; square < 64; square++)
+	{
+		for(int direction = 0; direction < RAY_DIRECTION_COUNT; direction++)
+		{
+			Bitboard line = tables.rays[direction][square] | tables.rays[(direction + 4) % RAY_DIRECTION_COUNT][square] | (1ULL << square);
+			for(int toSquare = 0; toSquare < 64; toSquare++)
+			{
+				if(tables.rays[direction][square] & (1ULL << toSquare))
+					tables.lines[square][toSquare] = line;
+			}
+		}
+	}
+
+	return tables;
+}
+
+inline constexpr AttackTables kAttackTables = GenerateAttackTables();
+
+//--------------------------------------------------------------------------------------------------
+
+inline Bitboard KnightAttacks(int square)					{ return kAttackTables.knight[square]; }
+inline Bitboard KingAttacks(int square)						{ return kAttackTables.king[square]; }
+inline Bitboard PawnAttacks(COLOUR colour, int square)		{ return kAttackTables.pawn[colour][square]; }
+
+inline Bitboard RayAttacks(RAY_DIRECTION direction, int square, Bitboard occupied)
+{
+	Bitboard attacks  = kAttackTables.rays[direction][square];
+	Bitboard blockers = attacks & occupied;
+	if(blockers)
+	{
+		//Everything beyond the nearest blocker is hidden behind it.
+		int blocker = direction < RAY_SOUTH ? LowestBit(blockers) : HighestBit(blockers);
+		attacks ^= kAttackTables.rays[direction][blocker];
+	}
+
+	return attacks;
+}
+
+//The whole rank, file or diagonal two squares share, themselves included. Empty if they share none.
+inline Bitboard LineBitboard(int fromSquare, int toSquare)	{ return kAttackTables.lines[fromSquare][toSquare]; }
+
+//Squares strictly between two squares that share a rank, file or diagonal. Empty if they do not.
+inline Bitboard BetweenBitboard(int fromSquare, int toSquare)
+{
+	Bitboard target = SquareBitboard(toSquare);
+	for(int direction = 0; direction < RAY_DIRECTION_COUNT; direction++)
+	{
+		if(kAttackTables.rays[direction][fromSquare] & target)
+			return RayAttacks((RAY_DIRECTION)direction, fromSquare, target) & ~target;
+	}
+
+	return 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+//          Slider tables
+// Every blocker arrangement on a slider's lines maps to a slot holding its attacks, so a rook or
+// bishop costs one lookup. Where the CPU has a fast PEXT the slot is the blockers squeezed
+// together, otherwise a multiply by a magic number hashes them without collisions. Both are built
+// once at start-up, in ChessBitboard.cpp.
+//--------------------------------------------------------------------------------------------------
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#define CHESS_HAS_PEXT
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define CHESS_HAS_PEXT
+#endif
+
+#ifdef CHESS_HAS_PEXT
+//Gathers the bits of value under mask into the low bits. Only call it if the CPU supports BMI2.
+inline uint64_t ParallelBitExtract(uint64_t value, uint64_t mask)
+{
+#ifdef _MSC_VER
+	return _pext_u64(value, mask);
+#else
+	//Written as assembly so it inlines without building the whole engine for BMI2.
+	uint64_t result;
+	__asm__("pextq %2, %1, %0" : "=r"(result) : "r"(value), "r"(mask));
+	return result;
+#endif
+}
+#endif
+
+struct SliderMagic
+{
+	const Bitboard* attacks;	//This square's slots.
+	Bitboard		mask;		//Squares whose blockers matter - The lines, less the edge at their ends.
+	Bitboard		magic;
+	int				shift;		//64 less the number of squares in mask.
+};
+
+struct SliderTables
+{
+	SliderTables();
+
+	bool		usePext;
+	SliderMagic rook[64];
+	SliderMagic bishop[64];
+	Bitboard	rookAttacks[0x19000];
+	Bitboard	bishopAttacks[0x1480];
+};
+
+extern const SliderTables kSliderTables;
+
+inline unsigned SliderIndex(const SliderMagic& magic, Bitboard occupied)
+{
+#ifdef CHESS_HAS_PEXT
+	if(kSliderTables.usePext)
+		return (unsigned)ParallelBitExtract(occupied, magic.mask);
+#endif
+	return (unsigned)(((occupied & magic.mask) * magic.magic) >> magic.shift);
+}
+
+inline Bitboard BishopAttacks(int square, Bitboard occupied)
+{
+	const SliderMagic& magic = kSliderTables.bishop[square];
+	return magic.attacks[SliderIndex(magic, occupied)];
+}
+
+inline Bitboard RookAttacks(int square, Bitboard occupied)
+{
+	const SliderMagic& magic = kSliderTables.rook[square];
+	return magic.attacks[SliderIndex(magic, occupied)];
+}
+
+inline Bitboard QueenAttacks(int square, Bitboard occupied)
+{
+	return BishopAttacks(square, occupied) | RookAttacks(square, occupied);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+#endif //_CHESS_BITBOARD_H
@@ -6,7 +6,8 @@
 #define CHESSCOMMONS_H
 
 #include "ChessConstants.h"
-#include "sdl_game.h"
+#include <cstdint>
+#include <string>
 
 //--------------------------------------------------------------------------------------------------
 
@@ -43,36 +44,49 @@ enum COLOUR
 
 //--------------------------------------------------------------------------------------------------
 
+enum CASTLING_RIGHTS
+{
+	CASTLE_NONE				= 0,
+	CASTLE_WHITE_KINGSIDE	= 1,
+	CASTLE_WHITE_QUEENSIDE	= 2,
+	CASTLE_BLACK_KINGSIDE	= 4,
+	CASTLE_BLACK_QUEENSIDE	= 8,
+
+	CASTLE_ALL				= 15
+};
+
+//--------------------------------------------------------------------------------------------------
+
+//One byte a square - The PIECE in the low three bits and the COLOUR above them. Whether a king or
+//rook has moved, or a pawn can be taken en'passant, is kept once on the Board rather than per piece.
 struct BoardPiece
 {
-	PIECE   piece;
-	COLOUR  colour;
-	bool	canEnPassant;
-	bool	hasMoved;			//Required for Castling move.
+	uint8_t code;
 
 	BoardPiece()
 	{
-		piece		 = PIECE_NONE;
-		colour		 = COLOUR_NONE;
-		canEnPassant = false;
-		hasMoved	 = false;
+		code = (uint8_t)(PIECE_NONE | (COLOUR_NONE << 3));
 	};
 
 	BoardPiece(PIECE type, COLOUR col)
 	{
-		piece		 = type;
-		colour		 = col;
-		canEnPassant = false;
-		hasMoved	 = false;
+		code = (uint8_t)(type | (col << 3));
 	};
+
+	PIECE	Piece() const			{ return (PIECE)(code & 7); }
+	COLOUR	Colour() const			{ return (COLOUR)(code >> 3); }
+	void	SetPiece(PIECE type)	{ code = (uint8_t)((code & ~7) | type); }
 };
 
 //--------------------------------------------------------------------------------------------------
 
+//The 64 squares fill one cache line, and what belongs to the position as a whole follows them.
 struct Board
 {
-	int			score;
 	BoardPiece	currentLayout[8][8];
+	COLOUR		sideToMove;
+	uint8_t		castlingRights;			//CASTLING_RIGHTS flags.
+	int8_t		enPassantSquare;		//Square (a1 = 0) a pawn has just double stepped over, or -1.
 
 	Board()
 	{
@@ -104,6 +118,9 @@ struct Board
 		for(int x = 0; x < kBoardDimensions; x++)
 			currentLayout[x][6] = BoardPiece(PIECE_PAWN, COLOUR_WHITE);
 
+		sideToMove		= COLOUR_WHITE;
+		castlingRights	= CASTLE_ALL;
+		enPassantSquare = -1;
 	};
 
 	Board(BoardPiece setup[8][8])
@@ -115,39 +132,61 @@ struct Board
 				currentLayout[x][y] = setup[x][y];
 			}
 		}
+
+		//Castling is allowed wherever the king and rook are still on their start squares.
+		sideToMove		= COLOUR_WHITE;
+		castlingRights	= CASTLE_ALL;
+		enPassantSquare = -1;
 	};
 };
 
 //--------------------------------------------------------------------------------------------------
 
+//Packed into 16 bits - The square the piece leaves and the square it lands on (a1 = 0 ... h8 = 63)
+//take six bits each, and the piece a pawn promotes to the top four, 0 for none. Castling and
+//en'passant need no flag, as the position shows which they are. A move from and to the same
+//square is no move at all.
 struct Move
 {
-	int from_X;
-	int from_Y;
-	int to_X;
-	int to_Y;
-	int score;	//Required only for ordering moves.
+	uint16_t data;
 
 	Move()
 	{
+		data = 0;
 	}
 
-	Move(int fromX, int fromY, int toX, int toY)
+	//Board coordinates, with y = 0 being BLACK's back rank.
+	Move(int fromX, int fromY, int toX, int toY, PIECE promotion = PIECE_NONE)
 	{
-		from_X = fromX;
-		from_Y = fromY;
-		to_X   = toX;
-		to_Y   = toY;
-		score  = 0;
+		data = (uint16_t)(((7 - fromY) * 8 + fromX) | (((7 - toY) * 8 + toX) << 6));
+		SetPromotion(promotion);
 	};
 
-	Move(SDL_Point fromPosition, SDL_Point toPosition)
+	static Move FromSquares(int fromSquare, int toSquare, PIECE promotion = PIECE_NONE)
+	{
+		Move move;
+		move.data = (uint16_t)(fromSquare | (toSquare << 6));
+		move.SetPromotion(promotion);
+		return move;
+	}
+
+	int	  FromSquare() const	{ return data & 0x3F; }
+	int	  ToSquare() const		{ return (data >> 6) & 0x3F; }
+	int	  FromX() const			{ return FromSquare() & 7; }
+	int	  FromY() const			{ return 7 - (FromSquare() >> 3); }
+	int	  ToX() const			{ return ToSquare() & 7; }
+	int	  ToY() const			{ return 7 - (ToSquare() >> 3); }
+	bool  IsNone() const		{ return FromSquare() == ToSquare(); }
+
+	PIECE Promotion() const		{ return (data >> 12) == 0 ? PIECE_NONE : (PIECE)(data >> 12); }
+	void  SetPromotion(PIECE promotion)
+	{
+		data = (uint16_t)((data & 0x0FFF) | ((promotion == PIECE_NONE ? 0 : promotion) << 12));
+	}
+
+	bool operator==(const Move& other) const
 	{
-		from_X = (int)fromPosition.x;
-		from_Y = (int)fromPosition.y;
-		to_X   = (int)toPosition.x;
-		to_Y   = (int)toPosition.y;
-		score  = 0;
+		return data == other.data;
 	};
 };
 
@@ -172,15 +211,6 @@ enum TURNSTATE
 
 //--------------------------------------------------------------------------------------------------
 
-struct ChessMove
-{
-	Move   theMove;
-	string startPosition;
-	string endPosition;
-};
-
-//--------------------------------------------------------------------------------------------------
-
 
 
 #endif //CHESSCOMMONS_H
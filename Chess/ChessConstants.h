@@ -5,6 +5,7 @@
 #pragma once
 
 #include <iostream>
+#include <string>
 using namespace::std;
 
 //File paths.
@@ -16,6 +17,8 @@ const string kChessSquareRedHighlightPath	= "Images/SquareHighlight.png";
 const string kChessSquareBlueHighlightPath	= "Images/PreviousMoveHighlight.png";
 const string kChessGameStatesPath			= "Images/GameState.png";
 const string kChessSelectAPiecePath			= "Images/SelectAPiece.png";
+const string kOpeningBookPath				= "Books/Book.bin";		//The AI searches every move when there is no book.
+const string kTablebasePath					= "Tablebases";			//Syzygy files. Endgames are searched as normal without them.
 
 //Screen dimensions.
 const int kChessScreenWidth					= 416;		//In pixels.
@@ -32,12 +35,36 @@ const float	kPreTurnTextTime				= 1.5f;
 const int kPreTurnTextWidth					= 240;
 const int kPreTurnTextHeight				= 52;
 
-//Search depth in MiniMax Algorithm.
+//Deepest search in MiniMax Algorithm. Iterative deepening works up to it.
 const unsigned int kSearchDepth				= 4;
 
-//Cut the number of moves down per ply.
-//This will be multiplied by current depth.
-const unsigned int kMaxMovesPerPly			= 20;
+//Time the AI may spend on a move, in milliseconds. Iterative deepening stops at whichever
+//of this or the search depth comes first.
+const unsigned int kSearchTimeLimitMS		= 2000;
 
-//Number of pieces at start of game.
-const unsigned int kTotalNumberOfStartingPieces = 16;
+//Deepest ply the search can reach, and so the longest principal variation.
+const int kMaxSearchPly						= 64;
+
+//Score for delivering checkmate. Mates found sooner score higher, so anything above
+//kMateThreshold is a forced mate.
+const int kMateScore						= 1000000;
+const int kMateThreshold					= kMateScore - 1000;
+
+//Threads searching each AI move. 0 uses every core.
+const unsigned int kSearchThreadCount		= 0;
+
+//Transposition table size in megabytes. Rounded down to a power of two buckets.
+const unsigned int kTranspositionTableSizeMB = 64;
+
+//Room in a move list. No legal position has more than 218 moves.
+const int kMaxMovesPerPosition				= 256;
+
+//Longest game the move history reserves room for up front.
+const unsigned int kMaxGamePly				= 1024;
+
+//Most pieces a position can have, kings included, to be looked up in the tablebases. Tables
+//with more pieces are never mapped.
+const int kTablebasePieceLimit				= 6;
+
+//Moves searched at each node under beam pruning. The rest are dropped unseen.
+const int kMaxMovesPerPly					= 20;
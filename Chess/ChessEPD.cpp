@@ -0,0 +1,232 @@
+//------------------------------------------------------------------------
+//  Extended Position Description - The FEN-like lines test suites such
+//  as WAC and STS are written in, with best and avoid moves.
+//------------------------------------------------------------------------
+
+#include "ChessEPD.h"
+#include "ChessNotation.h"
+#include "ChessPosition.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+//--------------------------------------------------------------------------------------------------
+
+namespace
+{
+	//Splits "bm Qxf7+ Nd5; id \"WAC.001\";" into operations. Quoted operands may hold spaces and ';'.
+	bool ParseOperations(const string& text, vector<EPDOperation>* operations)
+	{
+		EPDOperation operation;
+		string		 token;
+		bool		 haveToken = false;
+
+		auto endToken = [&]()
+		{
+			if(!haveToken)
+				return;
+
+			if(operation.opcode.empty())
+				operation.opcode = token;
+			else
+				operation.operands.push_back(token);
+
+			token.clear();
+			haveToken = false;
+		};
+
+		for(size_t index = 0; index < text.size(); index++)
+		{
+			char symbol = text[index];
+			if(symbol == '"')
+			{
+				size_t close = text.find('"', index + 1);
+				if(close == string::npos)
+					return false;
+
+				token	  += text.substr(index + 1, close - index - 1);
+				haveToken  = true;
+				index	   = close;
+			}
+			else if(symbol == ';')
+			{
+				endToken();
+				if(operation.opcode.empty())
+					return false;
+
+				operations->push_back(operation);
+				operation = EPDOperation();
+			}
+			else if(isspace((unsigned char)symbol))
+			{
+				endToken();
+			}
+			else
+			{
+				token	 += symbol;
+				haveToken = true;
+			}
+		}
+
+		//The last operation's ';' is often left off.
+		endToken();
+		if(!operation.opcode.empty())
+			operations->push_back(operation);
+
+		return true;
+	}
+
+	//----------------------------------------------------------------------------------------------
+
+	string QuoteOperand(const string& operand)
+	{
+		if(operand.empty() || operand.find_first_of(" \t;") != string::npos)
+			return "\"" + operand + "\"";
+		return operand;
+	}
+}
+
+//--------------------------------------------------------------------------------------------------
+
+bool EPDRecord::IsSolvedBy(const Move& move) const
+{
+	if(!bestMoves.empty() && find(bestMoves.begin(), bestMoves.end(), move) == bestMoves.end())
+		return false;
+
+	return find(avoidMoves.begin(), avoidMoves.end(), move) == avoidMoves.end();
+}
+
+//--------------------------------------------------------------------------------------------------
+
+bool ParseEPD(const string& line, EPDRecord* record)
+{
+	*record = EPDRecord();
+
+	istringstream fields(line);
+	string		  placement, side, castling, enPassant;
+	if(!(fields >> placement >> side >> castling >> enPassant))
+		return false;
+
+	string rest;
+	getline(fields, rest);
+
+	vector<EPDOperation> operations;
+	if(!ParseOperations(rest, &operations))
+		return false;
+
+	//The counters are operations in EPD, and fields in FEN.
+	string halfmove = "0";
+	string fullmove = "1";
+	for(const EPDOperation& operation : operations)
+	{
+		if(operation.opcode == "hmvc" && !operation.operands.empty())
+			halfmove = operation.operands[0];
+		else if(operation.opcode == "fmvn" && !operation.operands.empty())
+			fullmove = operation.operands[0];
+	}
+
+	Position position;
+	if(!position.LoadFen(placement + " " + side + " " + castling + " " + enPassant + " " + halfmove + " " + fullmove))
+		return false;
+	record->fen = position.ToFen();
+
+	for(const EPDOperation& operation : operations)
+	{
+		if(operation.opcode == "bm" || operation.opcode == "am")
+		{
+			vector<Move>* moves = operation.opcode == "bm" ? &record->bestMoves : &record->avoidMoves;
+			for(const string& operand : operation.operands)
+			{
+				Move move;
+				if(!MoveFromSAN(position, operand, &move))
+					return false;
+				moves->push_back(move);
+			}
+		}
+		else if(operation.opcode == "id")
+		{
+			record->id = operation.operands.empty() ? "" : operation.operands[0];
+		}
+		else if(operation.opcode != "hmvc" && operation.opcode != "fmvn")
+		{
+			record->operations.push_back(operation);
+		}
+	}
+
+	return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+string FormatEPD(const EPDRecord& record)
+{
+	Position position;
+	if(!position.LoadFen(record.fen))
+		return "";
+
+	//The FEN without its counters, which follow as operations unless they are the defaults.
+	istringstream fields(record.fen);
+	string		  placement, side, castling, enPassant;
+	fields >> placement >> side >> castling >> enPassant;
+
+	string text = placement + " " + side + " " + castling + " " + enPassant;
+
+	auto writeMoves = [&](const string& opcode, const vector<Move>& moves)
+	{
+		if(moves.empty())
+			return;
+
+		text += " " + opcode;
+		for(const Move& move : moves)
+			text += " " + MoveToSAN(position, move);
+		text += ";";
+	};
+
+	writeMoves("bm", record.bestMoves);
+	writeMoves("am", record.avoidMoves);
+
+	if(!record.id.empty())
+		text += " id \"" + record.id + "\";";
+
+	for(const EPDOperation& operation : record.operations)
+	{
+		text += " " + operation.opcode;
+		for(const string& operand : operation.operands)
+			text += " " + QuoteOperand(operand);
+		text += ";";
+	}
+
+	if(position.halfmoveClock != 0 || position.fullmoveNumber != 1)
+		text += " hmvc " + to_string(position.halfmoveClock) + "; fmvn " + to_string(position.fullmoveNumber) + ";";
+
+	return text;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+bool LoadEPDFile(const string& path, vector<EPDRecord>* records, int* skippedLines)
+{
+	ifstream file(path);
+	if(!file)
+		return false;
+
+	*skippedLines = 0;
+
+	string line;
+	while(getline(file, line))
+	{
+		size_t start = line.find_first_not_of(" \t\r");
+		if(start == string::npos || line[start] == '#')
+			continue;
+
+		EPDRecord record;
+		if(ParseEPD(line, &record))
+			records->push_back(record);
+		else
+			(*skippedLines)++;
+	}
+
+	return true;
+}
+
+//--------------------------------------------------------------------------------------------------
@@ -0,0 +1,52 @@
+//------------------------------------------------------------------------
+//  Extended Position Description - The FEN-like lines test suites such
+//  as WAC and STS are written in, with best and avoid moves.
+//------------------------------------------------------------------------
+
+#ifndef _CHESS_EPD_H
+#define _CHESS_EPD_H
+
+#include "ChessCommons.h"
+#include <string>
+#include <vector>
+using namespace std;
+
+//--------------------------------------------------------------------------------------------------
+
+//An opcode and its operands, e.g. bm with "Qxf7+" and "Nd5".
+struct EPDOperation
+{
+	string		   opcode;
+	vector<string> operands;		//Quotes already taken off.
+};
+
+//--------------------------------------------------------------------------------------------------
+
+struct EPDRecord
+{
+	string				 fen;			//Move counters from hmvc and fmvn, else 0 1.
+	string				 id;
+	vector<Move>		 bestMoves;		//bm - Playing any of them solves the position.
+	vector<Move>		 avoidMoves;	//am - Playing any of them fails it.
+	vector<EPDOperation> operations;	//Everything else, in the order written.
+
+	//A record with neither best nor avoid moves is solved by anything.
+	bool IsSolvedBy(const Move& move) const;
+};
+
+//--------------------------------------------------------------------------------------------------
+
+//The four position fields of a FEN, then operations, each an opcode and operands ended by ';'.
+//Returns false if the position is malformed, or a bm or am move isn't legal in it.
+bool   ParseEPD(const string& line, EPDRecord* record);
+
+//The other way round. Best and avoid moves are written in SAN.
+string FormatEPD(const EPDRecord& record);
+
+//Blank lines and those starting with # are skipped, and so are lines that don't parse - counted
+//in skippedLines. Returns false if the file can't be read.
+bool   LoadEPDFile(const string& path, vector<EPDRecord>* records, int* skippedLines);
+
+//--------------------------------------------------------------------------------------------------
+
+#endif //_CHESS_EPD_H
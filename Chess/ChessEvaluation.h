@@ -0,0 +1,186 @@
+//------------------------------------------------------------------------
+//  Evaluation terms, shared by the search and the running scores each
+//  Position keeps as moves are made.
+//------------------------------------------------------------------------
+
+#ifndef _CHESS_EVALUATION_H
+#define _CHESS_EVALUATION_H
+
+#include "ChessCommons.h"
+
+//--------------------------------------------------------------------------------------------------
+
+//Piece values in centipawns, for the middlegame and the endgame. Kings are never taken, so score nothing.
+constexpr int kMiddlegamePieceScores[kNumberOfPieces] = { 100, 320, 330, 500, 900, 0 };
+constexpr int kEndgamePieceScores[kNumberOfPieces]	  = { 120, 300, 320, 550, 950, 0 };
+
+//How much each piece counts towards the middlegame. The starting material adds up to kMaxPhase,
+//and the score slides towards the endgame tables as pieces come off.
+constexpr int kPhaseWeights[kNumberOfPieces] = { 0, 1, 1, 2, 4, 0 };
+constexpr int kMaxPhase						 = 24;
+
+//--------------------------------------------------------------------------------------------------
+//          Piece-square tables
+// Bonuses for where each piece stands, laid out as the board looks from White's side - a8 at the
+// top left, h1 at the bottom right. Black reads them mirrored.
+//--------------------------------------------------------------------------------------------------
+
+constexpr int kPawnMiddlegameTable[64] =
+{
+	  0,   0,   0,   0,   0,   0,   0,   0,
+	 50,  50,  50,  50,  50,  50,  50,  50,
+	 10,  10,  20,  30,  30,  20,  10,  10,
+	  5,   5,  10,  25,  25,  10,   5,   5,
+	  0,   0,   0,  20,  20,   0,   0,   0,
+	  5,  -5, -10,   0,   0, -10,  -5,   5,
+	  5,  10,  10, -20, -20,  10,  10,   5,
+	  0,   0,   0,   0,   0,   0,   0,   0
+};
+
+constexpr int kPawnEndgameTable[64] =
+{
+	  0,   0,   0,   0,   0,   0,   0,   0,
+	 80,  80,  80,  80,  80,  80,  80,  80,
+	 50,  50,  50,  50,  50,  50,  50,  50,
+	 30,  30,  30,  30,  30,  30,  30,  30,
+	 20,  20,  20,  20,  20,  20,  20,  20,
+	 10,  10,  10,  10,  10,  10,  10,  10,
+	 10,  10,  10,  10,  10,  10,  10,  10,
+	  0,   0,   0,   0,   0,   0,   0,   0
+};
+
+constexpr int kKnightTable[64] =
+{
+	-50, -40, -30, -30, -30, -30, -40, -50,
+	-40, -20,   0,   0,   0,   0, -20, -40,
+	-30,   0,  10,  15,  15,  10,   0, -30,
+	-30,   5,  15,  20,  20,  15,   5, -30,
+	-30,   0,  15,  20,  20,  15,   0, -30,
+	-30,   5,  10,  15,  15,  10,   5, -30,
+	-40, -20,   0,   5,   5,   0, -20, -40,
+	-50, -40, -30, -30, -30, -30, -40, -50
+};
+
+constexpr int kBishopTable[64] =
+{
+	-20, -10, -10, -10, -10, -10, -10, -20,
+	-10,   0,   0,   0,   0,   0,   0, -10,
+	-10,   0,   5,  10,  10,   5,   0, -10,
+	-10,   5,   5,  10,  10,   5,   5, -10,
+	-10,   0,  10,  10,  10,  10,   0, -10,
+	-10,  10,  10,  10,  10,  10,  10, -10,
+	-10,   5,   0,   0,   0,   0,   5, -10,
+	-20, -10, -10, -10, -10, -10, -10, -20
+};
+
+constexpr int kRookTable[64] =
+{
+	  0,   0,   0,   0,   0,   0,   0,   0,
+	  5,  10,  10,  10,  10,  10,  10,   5,
+	 -5,   0,   0,   0,   0,   0,   0,  -5,
+	 -5,   0,   0,   0,   0,   0,   0,  -5,
+	 -5,   0,   0,   0,   0,   0,   0,  -5,
+	 -5,   0,   0,   0,   0,   0,   0,  -5,
+	 -5,   0,   0,   0,   0,   0,   0,  -5,
+	  0,   0,   0,   5,   5,   0,   0,   0
+};
+
+constexpr int kQueenTable[64] =
+{
+	-20, -10, -10,  -5,  -5, -10, -10, -20,
+	-10,   0,   0,   0,   0,   0,   0, -10,
+	-10,   0,   5,   5,   5,   5,   0, -10,
+	 -5,   0,   5,   5,   5,   5,   0,  -5,
+	  0,   0,   5,   5,   5,   5,   0,  -5,
+	-10,   5,   5,   5,   5,   5,   0, -10,
+	-10,   0,   5,   0,   0,   0,   0, -10,
+	-20, -10, -10,  -5,  -5, -10, -10, -20
+};
+
+//The king hides behind its pawns while there is material about, then walks to the centre.
+constexpr int kKingMiddlegameTable[64] =
+{
+	-30, -40, -40, -50, -50, -40, -40, -30,
+	-30, -40, -40, -50, -50, -40, -40, -30,
+	-30, -40, -40, -50, -50, -40, -40, -30,
+	-30, -40, -40, -50, -50, -40, -40, -30,
+	-20, -30, -30, -40, -40, -30, -30, -20,
+	-10, -20, -20, -20, -20, -20, -20, -10,
+	 20,  20,   0,   0,   0,   0,  20,  20,
+	 20,  30,  10,   0,   0,  10,  30,  20
+};
+
+constexpr int kKingEndgameTable[64] =
+{
+	-50, -40, -30, -20, -20, -30, -40, -50,
+	-30, -20, -10,   0,   0, -10, -20, -30,
+	-30, -10,  20,  30,  30,  20, -10, -30,
+	-30, -10,  30,  40,  40,  30, -10, -30,
+	-30, -10,  30,  40,  40,  30, -10, -30,
+	-30, -10,  20,  30,  30,  20, -10, -30,
+	-30, -30,   0,   0,   0,   0, -30, -30,
+	-50, -30, -30, -30, -30, -30, -30, -50
+};
+
+//--------------------------------------------------------------------------------------------------
+
+//Piece value plus square bonus, for every colour, piece and square. Indexed by bitboard square, so
+//a lookup needs no flipping.
+struct PieceSquareTables
+{
+	int middlegame[2][kNumberOfPieces][64];		//[COLOUR][PIECE][square]
+	int endgame[2][kNumberOfPieces][64];
+};
+
+constexpr PieceSquareTables GeneratePieceSquareTables()
+{
+	const int* middlegameTables[kNumberOfPieces] = { kPawnMiddlegameTable, kKnightTable, kBishopTable, kRookTable, kQueenTable, kKingMiddlegameTable };
+	const int* endgameTables[kNumberOfPieces]	 = { kPawnEndgameTable,	   kKnightTable, kBishopTable, kRookTable, kQueenTable, kKingEndgameTable };
+
+	PieceSquareTables tables = {};
+	for(int piece = 0; piece < kNumberOfPieces; piece++)
+	{
+		for(int square = 0; square < 64; square++)
+		{
+			//The layout above puts a8 first, so White flips the rank and Black, seeing the board
+			//from the other side, reads it as it is.
+			int whiteIndex = square ^ 56;
+			int blackIndex = square;
+
+			tables.middlegame[COLOUR_WHITE][piece][square] = kMiddlegamePieceScores[piece] + middlegameTables[piece][whiteIndex];
+			tables.middlegame[COLOUR_BLACK][piece][square] = kMiddlegamePieceScores[piece] + middlegameTables[piece][blackIndex];
+			tables.endgame[COLOUR_WHITE][piece][square]	   = kEndgamePieceScores[piece] + endgameTables[piece][whiteIndex];
+			tables.endgame[COLOUR_BLACK][piece][square]	   = kEndgamePieceScores[piece] + endgameTables[piece][blackIndex];
+		}
+	}
+	return tables;
+}
+
+inline constexpr PieceSquareTables kPieceSquareTables = GeneratePieceSquareTables();
+
+//--------------------------------------------------------------------------------------------------
+
+//Each side's score totals, updated by the difference whenever a piece is added, removed or moved.
+struct EvalAccumulator
+{
+	int middlegame[2];		//[COLOUR]
+	int endgame[2];
+	int phase;				//Sum of kPhaseWeights for every piece on the board. Promotions can take it past kMaxPhase.
+
+	bool operator==(const EvalAccumulator& other) const = default;
+};
+
+//Blends the middlegame and endgame scores by how much material is left, from colour's point of view.
+inline int TaperedScore(const EvalAccumulator& eval, COLOUR colour)
+{
+	COLOUR opponent	  = colour == COLOUR_WHITE ? COLOUR_BLACK : COLOUR_WHITE;
+	int	   middlegame = eval.middlegame[colour] - eval.middlegame[opponent];
+	int	   endgame	  = eval.endgame[colour] - eval.endgame[opponent];
+	int	   phase	  = eval.phase < kMaxPhase ? eval.phase : kMaxPhase;
+
+	return (middlegame * phase + endgame * (kMaxPhase - phase)) / kMaxPhase;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+#endif //_CHESS_EVALUATION_H
@@ -0,0 +1,105 @@
+//------------------------------------------------------------------------
+//  Read-only memory-mapped file, for the opening book and tablebases.
+//  Pages are only read from disk when they are first touched.
+//------------------------------------------------------------------------
+
+#include "ChessMappedFile.h"
+
+#ifdef _WIN32
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+//--------------------------------------------------------------------------------------------------
+
+MappedFile::MappedFile()
+{
+	mData = nullptr;
+	mSize = 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+//--------------------------------------------------------------------------------------------------
+
+bool MappedFile::Open(const string& path)
+{
+	Close();
+
+	const void* mapped = nullptr;
+	size_t		size   = 0;
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if(file == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER fileSize;
+	if(GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+	{
+		size = (size_t)fileSize.QuadPart;
+
+		//The view keeps the file mapped once both handles are closed.
+		HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if(mapping != nullptr)
+		{
+			mapped = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+			CloseHandle(mapping);
+		}
+	}
+	CloseHandle(file);
+#else
+	int file = open(path.c_str(), O_RDONLY);
+	if(file < 0)
+		return false;
+
+	struct stat fileStatus;
+	if(fstat(file, &fileStatus) == 0 && fileStatus.st_size > 0)
+	{
+		size = (size_t)fileStatus.st_size;
+
+		//The mapping outlives the descriptor.
+		void* view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+		if(view != MAP_FAILED)
+			mapped = view;
+	}
+	close(file);
+#endif
+
+	if(mapped == nullptr)
+		return false;
+
+	mData = (const unsigned char*)mapped;
+	mSize = size;
+	return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void MappedFile::Close()
+{
+	if(mData == nullptr)
+		return;
+
+#ifdef _WIN32
+	UnmapViewOfFile(mData);
+#else
+	munmap((void*)mData, mSize);
+#endif
+
+	mData = nullptr;
+	mSize = 0;
+}
+
+//--------------------------------------------------------------------------------------------------
@@ -0,0 +1,41 @@
+//------------------------------------------------------------------------
+//  Read-only memory-mapped file, for the opening book and tablebases.
+//  Pages are only read from disk when they are first touched.
+//------------------------------------------------------------------------
+
+#ifndef _CHESS_MAPPEDFILE_H
+#define _CHESS_MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+using namespace std;
+
+//--------------------------------------------------------------------------------------------------
+
+class MappedFile
+{
+//--------------------------------------------------------------------------------------------------
+public:
+	MappedFile();
+	~MappedFile();
+
+	MappedFile(const MappedFile&)			 = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	//Returns false, leaving nothing mapped, if the file is missing or empty.
+	bool				 Open(const string& path);
+	void				 Close();
+
+	bool				 IsOpen() const		{ return mData != nullptr; }
+	const unsigned char* GetData() const	{ return mData; }
+	size_t				 GetSize() const	{ return mSize; }
+
+//--------------------------------------------------------------------------------------------------
+private:
+	const unsigned char* mData;
+	size_t				 mSize;
+};
+
+//--------------------------------------------------------------------------------------------------
+
+#endif //_CHESS_MAPPEDFILE_H
@@ -0,0 +1,605 @@
+//------------------------------------------------------------------------
+//  Move generation and check detection on a bitboard Position.
+//------------------------------------------------------------------------
+
+#include "ChessMoveGenerator.h"
+
+//--------------------------------------------------------------------------------------------------
+
+namespace
+{
+	void AddMove(int fromSquare, int toSquare, PIECE moving, MoveList* moves)
+	{
+		Move move = Move::FromSquares(fromSquare, toSquare);
+
+		//A pawn reaching the back rank gets one move per piece it can become.
+		if(moving == PIECE_PAWN && (RankOfSquare(toSquare) == 0 || RankOfSquare(toSquare) == 7))
+		{
+			for(int piece = PIECE_QUEEN; piece >= PIECE_KNIGHT; piece--)
+			{
+				move.SetPromotion((PIECE)piece);
+				moves->Add(move);
+			}
+		}
+		else
+		{
+			moves->Add(move);
+		}
+	}
+
+	//----------------------------------------------------------------------------------------------
+
+	void AddMovesFromBitboard(int fromSquare, Bitboard targets, PIECE moving, MoveList* moves)
+	{
+		while(targets)
+			AddMove(fromSquare, PopLowestBit(&targets), moving, moves);
+	}
+
+	//----------------------------------------------------------------------------------------------
+
+	enum GENERATE_TYPE
+	{
+		GENERATE_ALL,
+		GENERATE_CAPTURES,			//Captures and promotions.
+		GENERATE_QUIETS				//Everything else.
+	};
+
+	//----------------------------------------------------------------------------------------------
+
+	void GeneratePawnMoves(const Position& position, GENERATE_TYPE type, MoveList* moves)
+	{
+		COLOUR	 us			= position.sideToMove;
+		Bitboard empty		= ~position.occupancy[COLOUR_NONE];
+		Bitboard enemies	= position.occupancy[OppositeColour(us)];
+		int		 forward	= us == COLOUR_WHITE ? 8 : -8;
+		int		 startRank	= us == COLOUR_WHITE ? 1 : 6;
+
+		Bitboard pawns = position.pieces[us][PIECE_PAWN];
+		while(pawns)
+		{
+			int square = PopLowestBit(&pawns);
+
+			//Single and double step FORWARD.
+			int	 singleStep = square + forward;
+			bool promotes	= RankOfSquare(singleStep) == 0 || RankOfSquare(singleStep) == 7;
+			if(empty & SquareBitboard(singleStep))
+			{
+				if(type == GENERATE_ALL || (type == GENERATE_CAPTURES) == promotes)
+					AddMove(square, singleStep, PIECE_PAWN, moves);
+
+				int doubleStep = singleStep + forward;
+				if(type != GENERATE_CAPTURES && RankOfSquare(square) == startRank && (empty & SquareBitboard(doubleStep)))
+					AddMove(square, doubleStep, PIECE_PAWN, moves);
+			}
+
+			if(type == GENERATE_QUIETS)
+				continue;
+
+			//Take a piece move.
+			Bitboard attacks = PawnAttacks(us, square);
+			AddMovesFromBitboard(square, attacks & enemies, PIECE_PAWN, moves);
+
+			//En'Passant move.
+			if(position.enPassantSquare != kNoSquare && (attacks & SquareBitboard(position.enPassantSquare)))
+				AddMove(square, position.enPassantSquare, PIECE_PAWN, moves);
+		}
+	}
+
+	//----------------------------------------------------------------------------------------------
+
+	//Knight, slider and king moves landing on any of the target squares.
+	void GeneratePieceMoves(const Position& position, Bitboard targets, MoveList* moves)
+	{
+		COLOUR us = position.sideToMove;
+
+		Bitboard knights = position.pieces[us][PIECE_KNIGHT];
+		while(knights)
+		{
+			int square = PopLowestBit(&knights);
+			AddMovesFromBitboard(square, KnightAttacks(square) & targets, PIECE_KNIGHT, moves);
+		}
+
+		Bitboard occupied = position.occupancy[COLOUR_NONE];
+		Bitboard bishops  = position.pieces[us][PIECE_BISHOP];
+		while(bishops)
+		{
+			int square = PopLowestBit(&bishops);
+			AddMovesFromBitboard(square, BishopAttacks(square, occupied) & targets, PIECE_BISHOP, moves);
+		}
+
+		Bitboard rooks = position.pieces[us][PIECE_ROOK];
+		while(rooks)
+		{
+			int square = PopLowestBit(&rooks);
+			AddMovesFromBitboard(square, RookAttacks(square, occupied) & targets, PIECE_ROOK, moves);
+		}
+
+		Bitboard queens = position.pieces[us][PIECE_QUEEN];
+		while(queens)
+		{
+			int square = PopLowestBit(&queens);
+			AddMovesFromBitboard(square, QueenAttacks(square, occupied) & targets, PIECE_QUEEN, moves);
+		}
+
+		int kingSquare = position.KingSquare(us);
+		AddMovesFromBitboard(kingSquare, KingAttacks(kingSquare) & targets, PIECE_KING, moves);
+	}
+
+	//----------------------------------------------------------------------------------------------
+
+	void GenerateCastlingMoves(const Position& position, MoveList* moves)
+	{
+		COLOUR	 us		  = position.sideToMove;
+		COLOUR	 them	  = OppositeColour(us);
+		Bitboard occupied = position.occupancy[COLOUR_NONE];
+
+		int kingSquare	  = us == COLOUR_WHITE ? kSquareE1 : kSquareE8;
+		int kingside	  = us == COLOUR_WHITE ? CASTLE_WHITE_KINGSIDE : CASTLE_BLACK_KINGSIDE;
+		int queenside	  = us == COLOUR_WHITE ? CASTLE_WHITE_QUEENSIDE : CASTLE_BLACK_QUEENSIDE;
+
+		//Can CASTLE if not in CHECK, and never through a CHECK position. The landing square is
+		//tested with the other king moves in IsLegalMove.
+		if((position.castlingRights & (kingside | queenside)) == 0 || IsSquareAttacked(position, kingSquare, them))
+			return;
+
+		if((position.castlingRights & kingside) &&
+		   (occupied & (SquareBitboard(kingSquare + 1) | SquareBitboard(kingSquare + 2))) == 0 &&
+		   !IsSquareAttacked(position, kingSquare + 1, them))
+		{
+			AddMove(kingSquare, kingSquare + 2, PIECE_KING, moves);
+		}
+
+		if((position.castlingRights & queenside) &&
+		   (occupied & (SquareBitboard(kingSquare - 1) | SquareBitboard(kingSquare - 2) | SquareBitboard(kingSquare - 3))) == 0 &&
+		   !IsSquareAttacked(position, kingSquare - 1, them))
+		{
+			AddMove(kingSquare, kingSquare - 2, PIECE_KING, moves);
+		}
+	}
+
+	//----------------------------------------------------------------------------------------------
+
+	//En'passant removes two pieces from one rank, which the pin masks cannot see. It is rare enough
+	//to simply test with the pieces taken off.
+	bool IsEnPassantLegal(const Position& position, int kingSquare, int fromSquare, int toSquare)
+	{
+		COLOUR	 us		  = position.sideToMove;
+		COLOUR	 them	  = OppositeColour(us);
+		Bitboard captured = SquareBitboard(toSquare + (us == COLOUR_WHITE ? -8 : 8));
+		Bitboard occupied = (position.occupancy[COLOUR_NONE] ^ SquareBitboard(fromSquare) ^ captured) | SquareBitboard(toSquare);
+
+		return (AttackersTo(position, kingSquare, them, occupied) & ~captured) == 0;
+	}
+
+	//----------------------------------------------------------------------------------------------
+
+	//Every square byColour attacks, with sliders blocked by the occupied bitboard passed in.
+	Bitboard AttackedSquares(const Position& position, COLOUR byColour, Bitboard occupied)
+	{
+		const Bitboard* attacker = position.pieces[byColour];
+
+		Bitboard pawns	  = attacker[PIECE_PAWN];
+		Bitboard attacked = byColour == COLOUR_WHITE ? ((pawns & ~kFileABitboard) << 7) | ((pawns & ~kFileHBitboard) << 9)
+													 : ((pawns & ~kFileABitboard) >> 9) | ((pawns & ~kFileHBitboard) >> 7);
+
+		Bitboard knights = attacker[PIECE_KNIGHT];
+		while(knights)
+			attacked |= KnightAttacks(PopLowestBit(&knights));
+
+		Bitboard diagonals = attacker[PIECE_BISHOP] | attacker[PIECE_QUEEN];
+		while(diagonals)
+			attacked |= BishopAttacks(PopLowestBit(&diagonals), occupied);
+
+		Bitboard straights = attacker[PIECE_ROOK] | attacker[PIECE_QUEEN];
+		while(straights)
+			attacked |= RookAttacks(PopLowestBit(&straights), occupied);
+
+		if(attacker[PIECE_KING])
+			attacked |= KingAttacks(LowestBit(attacker[PIECE_KING]));
+
+		return attacked;
+	}
+
+	//----------------------------------------------------------------------------------------------
+
+	//Whether any piece but the king can move, when not in check. Each piece only has to have
+	//somewhere to go, and a pinned one somewhere along its pin.
+	bool HasAnyPieceMove(const Position& position, const AttackMap& attackMap)
+	{
+		COLOUR	 us		  = position.sideToMove;
+		Bitboard occupied = position.occupancy[COLOUR_NONE];
+		Bitboard targets  = ~position.occupancy[us];
+
+		auto canReach = [&](int square, Bitboard reach)
+		{
+			if(attackMap.pinned & SquareBitboard(square))
+				reach &= LineBitboard(attackMap.kingSquare, square);
+			return (reach & targets) != 0;
+		};
+
+		//A pinned knight can never move, so only the free ones are looked at.
+		Bitboard knights = position.pieces[us][PIECE_KNIGHT] & ~attackMap.pinned;
+		while(knights)
+		{
+			if(KnightAttacks(PopLowestBit(&knights)) & targets)
+				return true;
+		}
+
+		Bitboard diagonals = position.pieces[us][PIECE_BISHOP] | position.pieces[us][PIECE_QUEEN];
+		while(diagonals)
+		{
+			int square = PopLowestBit(&diagonals);
+			if(canReach(square, BishopAttacks(square, occupied)))
+				return true;
+		}
+
+		Bitboard straights = position.pieces[us][PIECE_ROOK] | position.pieces[us][PIECE_QUEEN];
+		while(straights)
+		{
+			int square = PopLowestBit(&straights);
+			if(canReach(square, RookAttacks(square, occupied)))
+				return true;
+		}
+
+		//A pawn needs the square ahead empty, or an enemy to take. En'passant is left to the caller.
+		Bitboard enemies = position.occupancy[OppositeColour(us)];
+		int		 forward = us == COLOUR_WHITE ? 8 : -8;
+		Bitboard pawns	 = position.pieces[us][PIECE_PAWN];
+		while(pawns)
+		{
+			int		 square = PopLowestBit(&pawns);
+			Bitboard reach	= (PawnAttacks(us, square) & enemies) | (SquareBitboard(square + forward) & ~occupied);
+			if(canReach(square, reach))
+				return true;
+		}
+
+		return false;
+	}
+}
+
+//--------------------------------------------------------------------------------------------------
+
+Bitboard AttackersTo(const Position& position, int square, COLOUR byColour, Bitboard occupied)
+{
+	const Bitboard* attacker = position.pieces[byColour];
+
+	return (PawnAttacks(OppositeColour(byColour), square) & attacker[PIECE_PAWN])   |
+		   (KnightAttacks(square)						& attacker[PIECE_KNIGHT]) |
+		   (KingAttacks(square)							& attacker[PIECE_KING])   |
+		   (BishopAttacks(square, occupied)				& (attacker[PIECE_BISHOP] | attacker[PIECE_QUEEN])) |
+		   (RookAttacks(square, occupied)				& (attacker[PIECE_ROOK]	  | attacker[PIECE_QUEEN]));
+}
+
+//--------------------------------------------------------------------------------------------------
+
+bool IsSquareAttacked(const Position& position, int square, COLOUR byColour)
+{
+	return AttackersTo(position, square, byColour, position.occupancy[COLOUR_NONE]) != 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+bool IsInCheck(const Position& position, COLOUR colour)
+{
+	if(position.pieces[colour][PIECE_KING] == 0)
+		return false;
+
+	if(colour == position.sideToMove && position.hasAttackMap)
+		return position.attackMap.checkers != 0;
+
+	return IsSquareAttacked(position, position.KingSquare(colour), OppositeColour(colour));
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void GeneratePseudoLegalMoves(const Position& position, MoveList* moves)
+{
+	//Remove any previously stored move options.
+	moves->Clear();
+
+	//Without a king there is nothing to keep safe, and nothing sensible to generate.
+	if(position.pieces[position.sideToMove][PIECE_KING] == 0)
+		return;
+
+	GeneratePawnMoves(position, GENERATE_ALL, moves);
+	GeneratePieceMoves(position, ~position.occupancy[position.sideToMove], moves);
+	GenerateCastlingMoves(position, moves);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void GeneratePseudoLegalCaptures(const Position& position, MoveList* moves)
+{
+	moves->Clear();
+
+	if(position.pieces[position.sideToMove][PIECE_KING] == 0)
+		return;
+
+	GeneratePawnMoves(position, GENERATE_CAPTURES, moves);
+	GeneratePieceMoves(position, position.occupancy[OppositeColour(position.sideToMove)], moves);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void GeneratePseudoLegalQuiets(const Position& position, MoveList* moves)
+{
+	if(position.pieces[position.sideToMove][PIECE_KING] == 0)
+		return;
+
+	GeneratePawnMoves(position, GENERATE_QUIETS, moves);
+	GeneratePieceMoves(position, ~position.occupancy[COLOUR_NONE], moves);
+	GenerateCastlingMoves(position, moves);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+bool IsPseudoLegalMove(const Position& position, const Move& move)
+{
+	COLOUR us		  = position.sideToMove;
+	int	   fromSquare = MoveFromSquare(move);
+	int	   toSquare	  = MoveToSquare(move);
+
+	if(fromSquare == toSquare || position.ColourOn(fromSquare) != us || (position.occupancy[us] & SquareBitboard(toSquare)))
+		return false;
+
+	//Only a pawn reaching the back rank promotes, and then it must.
+	PIECE moving   = position.PieceOn(fromSquare);
+	bool  promotes = moving == PIECE_PAWN && (RankOfSquare(toSquare) == 0 || RankOfSquare(toSquare) == 7);
+	PIECE promotion = move.Promotion();
+	if(promotes != (promotion != PIECE_NONE) || (promotes && (promotion < PIECE_KNIGHT || promotion > PIECE_QUEEN)))
+		return false;
+
+	Bitboard to		  = SquareBitboard(toSquare);
+	Bitboard occupied = position.occupancy[COLOUR_NONE];
+	switch(moving)
+	{
+		case PIECE_PAWN:
+		{
+			Bitboard enemies = position.occupancy[OppositeColour(us)];
+			if(position.enPassantSquare != kNoSquare)
+				enemies |= SquareBitboard(position.enPassantSquare);
+
+			if(PawnAttacks(us, fromSquare) & enemies & to)
+				return true;
+
+			//Pushes need every square up to and including the destination empty.
+			int forward = us == COLOUR_WHITE ? 8 : -8;
+			if(toSquare == fromSquare + forward)
+				return (occupied & to) == 0;
+
+			int startRank = us == COLOUR_WHITE ? 1 : 6;
+			if(toSquare == fromSquare + 2 * forward && RankOfSquare(fromSquare) == startRank)
+				return (occupied & (to | SquareBitboard(fromSquare + forward))) == 0;
+
+			return false;
+		}
+
+		case PIECE_KNIGHT:	return (KnightAttacks(fromSquare) & to) != 0;
+		case PIECE_BISHOP:	return (BishopAttacks(fromSquare, occupied) & to) != 0;
+		case PIECE_ROOK:	return (RookAttacks(fromSquare, occupied) & to) != 0;
+		case PIECE_QUEEN:	return (QueenAttacks(fromSquare, occupied) & to) != 0;
+
+		case PIECE_KING:
+		{
+			if(KingAttacks(fromSquare) & to)
+				return true;
+
+			//Castling has enough conditions that it is simplest to ask the generator.
+			MoveList castlingMoves;
+			GenerateCastlingMoves(position, &castlingMoves);
+			for(const Move& castle : castlingMoves)
+			{
+				if(castle == move)
+					return true;
+			}
+			return false;
+		}
+
+		default:
+			return false;
+	}
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void ComputeAttackMap(const Position& position, AttackMap* attackMap)
+{
+	COLOUR	 us		  = position.sideToMove;
+	COLOUR	 them	  = OppositeColour(us);
+	Bitboard occupied = position.occupancy[COLOUR_NONE];
+	int		 king	  = position.KingSquare(us);
+
+	attackMap->kingSquare = king;
+	attackMap->checkers	  = AttackersTo(position, king, them, occupied);
+	attackMap->pinned	  = 0;
+
+	//The king is lifted off the board so it cannot hide behind itself from a slider.
+	attackMap->attacked	  = AttackedSquares(position, them, occupied ^ position.pieces[us][PIECE_KING]);
+
+	//Single check can be answered by taking the checker or stepping in front of it. Double check
+	//leaves only king moves.
+	if(attackMap->checkers == 0)
+		attackMap->checkMask = ~0ULL;
+	else if(CountBits(attackMap->checkers) == 1)
+		attackMap->checkMask = attackMap->checkers | BetweenBitboard(king, LowestBit(attackMap->checkers));
+	else
+		attackMap->checkMask = 0;
+
+	//Enemy sliders that would see the king through exactly one of our pieces pin it.
+	const Bitboard* enemy	= position.pieces[them];
+	Bitboard		snipers = (RookAttacks(king, position.occupancy[them])   & (enemy[PIECE_ROOK]	| enemy[PIECE_QUEEN])) |
+							  (BishopAttacks(king, position.occupancy[them]) & (enemy[PIECE_BISHOP] | enemy[PIECE_QUEEN]));
+	while(snipers)
+	{
+		Bitboard inTheWay = BetweenBitboard(king, PopLowestBit(&snipers)) & occupied;
+		if(CountBits(inTheWay) == 1 && (inTheWay & position.occupancy[us]))
+			attackMap->pinned |= inTheWay;
+	}
+}
+
+//--------------------------------------------------------------------------------------------------
+
+const AttackMap& GetAttackMap(const Position& position)
+{
+	if(!position.hasAttackMap)
+	{
+		ComputeAttackMap(position, &position.attackMap);
+		position.hasAttackMap = true;
+	}
+
+	return position.attackMap;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+bool IsLegalMove(const Position& position, const AttackMap& attackMap, const Move& move)
+{
+	int		 fromSquare = MoveFromSquare(move);
+	int		 toSquare	= MoveToSquare(move);
+	Bitboard to			= SquareBitboard(toSquare);
+
+	//The king must not step onto an attacked square.
+	if(fromSquare == attackMap.kingSquare)
+		return (attackMap.attacked & to) == 0;
+
+	if(toSquare == position.enPassantSquare && (position.pieces[position.sideToMove][PIECE_PAWN] & SquareBitboard(fromSquare)))
+		return IsEnPassantLegal(position, attackMap.kingSquare, fromSquare, toSquare);
+
+	if((attackMap.checkMask & to) == 0)
+		return false;
+
+	//A pinned piece may only move along the line between the king and its pinner.
+	if((attackMap.pinned & SquareBitboard(fromSquare)) && (LineBitboard(attackMap.kingSquare, fromSquare) & to) == 0)
+		return false;
+
+	return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+bool GivesCheck(const Position& position, const Move& move)
+{
+	COLOUR us	= position.sideToMove;
+	COLOUR them = OppositeColour(us);
+	if(position.pieces[them][PIECE_KING] == 0)
+		return false;
+
+	int		 kingSquare = position.KingSquare(them);
+	int		 fromSquare = MoveFromSquare(move);
+	int		 toSquare	= MoveToSquare(move);
+	PIECE	 moving		= position.PieceOn(fromSquare);
+	Bitboard occupied	= (position.occupancy[COLOUR_NONE] ^ SquareBitboard(fromSquare)) | SquareBitboard(toSquare);
+	Bitboard moved		= SquareBitboard(fromSquare);	//Our pieces no longer where the bitboards have them.
+
+	//What stands on the destination once the move is made - A promoted pawn checks as its new piece.
+	PIECE placed = moving;
+	if(moving == PIECE_PAWN)
+	{
+		if(toSquare == position.enPassantSquare)
+			occupied ^= SquareBitboard(toSquare + (us == COLOUR_WHITE ? -8 : 8));
+		else if(RankOfSquare(toSquare) == 0 || RankOfSquare(toSquare) == 7)
+			placed = move.Promotion() != PIECE_NONE ? move.Promotion() : PIECE_QUEEN;
+	}
+	else if(moving == PIECE_KING && (toSquare - fromSquare == 2 || fromSquare - toSquare == 2))
+	{
+		//Castling - Only the rook can give check, from the square the king passed over.
+		int rookFrom = toSquare > fromSquare ? fromSquare + 3 : fromSquare - 4;
+		int rookTo	 = (fromSquare + toSquare) / 2;
+		occupied = (occupied ^ SquareBitboard(rookFrom)) | SquareBitboard(rookTo);
+		moved	|= SquareBitboard(rookFrom);
+
+		if(RookAttacks(rookTo, occupied) & SquareBitboard(kingSquare))
+			return true;
+	}
+
+	Bitboard attacks = 0;
+	switch(placed)
+	{
+		case PIECE_PAWN:   attacks = PawnAttacks(us, toSquare);		   break;
+		case PIECE_KNIGHT: attacks = KnightAttacks(toSquare);		   break;
+		case PIECE_BISHOP: attacks = BishopAttacks(toSquare, occupied); break;
+		case PIECE_ROOK:   attacks = RookAttacks(toSquare, occupied);   break;
+		case PIECE_QUEEN:  attacks = QueenAttacks(toSquare, occupied);  break;
+		default:														   break;
+	}
+	if(attacks & SquareBitboard(kingSquare))
+		return true;
+
+	//Discovered check - A slider of ours that the move has uncovered.
+	const Bitboard* attacker = position.pieces[us];
+	Bitboard sliders = (BishopAttacks(kingSquare, occupied) & (attacker[PIECE_BISHOP] | attacker[PIECE_QUEEN])) |
+					   (RookAttacks(kingSquare, occupied)	& (attacker[PIECE_ROOK]	  | attacker[PIECE_QUEEN]));
+
+	return (sliders & ~moved) != 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void GenerateMoves(const Position& position, MoveList* moves)
+{
+	MoveList pseudoLegalMoves;
+	GeneratePseudoLegalMoves(position, &pseudoLegalMoves);
+
+	moves->Clear();
+	if(pseudoLegalMoves.Empty())
+		return;
+
+	const AttackMap& attackMap = GetAttackMap(position);
+	for(const Move& move : pseudoLegalMoves)
+	{
+		if(IsLegalMove(position, attackMap, move))
+			moves->Add(move);
+	}
+}
+
+//--------------------------------------------------------------------------------------------------
+
+bool HasAnyLegalMove(const Position& position)
+{
+	if(position.pieces[position.sideToMove][PIECE_KING] == 0)
+		return false;
+
+	//Castling is left out - Whenever it is legal, so is the king's step towards the rook.
+	const AttackMap& attackMap = GetAttackMap(position);
+	if(KingAttacks(attackMap.kingSquare) & ~position.occupancy[position.sideToMove] & ~attackMap.attacked)
+		return true;
+
+	//Double check leaves nothing but the king.
+	if(CountBits(attackMap.checkers) > 1)
+		return false;
+
+	//Out of check, most positions are answered without generating anything.
+	if(attackMap.checkers == 0)
+	{
+		if(HasAnyPieceMove(position, attackMap))
+			return true;
+		if(position.enPassantSquare == kNoSquare)
+			return false;
+	}
+
+	//In check, or down to an en'passant capture - Rare enough to generate the moves and try them.
+	MoveList pseudoLegalMoves;
+	GeneratePseudoLegalMoves(position, &pseudoLegalMoves);
+
+	for(const Move& move : pseudoLegalMoves)
+	{
+		if(IsLegalMove(position, attackMap, move))
+			return true;
+	}
+
+	return false;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+GAMESTATE GetGameState(const Position& position)
+{
+	bool inCheck = GetAttackMap(position).checkers != 0;
+
+	if(HasAnyLegalMove(position))
+		return inCheck ? GAMESTATE_CHECK : GAMESTATE_NORMAL;
+
+	return inCheck ? GAMESTATE_CHECKMATE : GAMESTATE_STALEMATE;
+}
+
+//--------------------------------------------------------------------------------------------------
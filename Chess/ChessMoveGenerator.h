@@ -0,0 +1,56 @@
+//------------------------------------------------------------------------
+//  Move generation and check detection on a bitboard Position.
+//------------------------------------------------------------------------
+
+#ifndef _CHESS_MOVEGENERATOR_H
+#define _CHESS_MOVEGENERATOR_H
+
+#include "ChessPosition.h"
+#include "ChessMoveList.h"
+
+//--------------------------------------------------------------------------------------------------
+
+//Every piece of byColour attacking square, with sliders blocked by the occupied bitboard passed in.
+Bitboard AttackersTo(const Position& position, int square, COLOUR byColour, Bitboard occupied);
+
+bool	 IsSquareAttacked(const Position& position, int square, COLOUR byColour);
+bool	 IsInCheck(const Position& position, COLOUR colour);
+
+//Moves for the side to move that may leave its own king in check. Previously stored moves are
+//cleared. Test each with IsLegalMove before playing it.
+void	 GeneratePseudoLegalMoves(const Position& position, MoveList* moves);
+
+//As above, but only captures and promotions - The moves that change the material balance.
+void	 GeneratePseudoLegalCaptures(const Position& position, MoveList* moves);
+
+//Every other pseudo-legal move. These are added after any moves already stored, so a move picker
+//can keep its captures and quiet moves in one list.
+void	 GeneratePseudoLegalQuiets(const Position& position, MoveList* moves);
+
+//Whether a move from somewhere else - The hash table, or a sibling node - can be played here.
+bool	 IsPseudoLegalMove(const Position& position, const Move& move);
+
+//Works out the AttackMap from scratch. GetAttackMap does the same, but only the first time it is
+//asked about a position, keeping the result in the position until it changes.
+void			 ComputeAttackMap(const Position& position, AttackMap* attackMap);
+const AttackMap& GetAttackMap(const Position& position);
+
+//Checks a pseudo-legal move against the AttackMap with a few mask tests, without making it.
+bool	 IsLegalMove(const Position& position, const AttackMap& attackMap, const Move& move);
+
+//Whether a legal move checks the enemy king, directly or by uncovering a slider, without making it.
+bool	 GivesCheck(const Position& position, const Move& move);
+
+//All legal moves for the side to move. Previously stored moves are cleared.
+void	 GenerateMoves(const Position& position, MoveList* moves);
+
+//Out of check this is answered from the AttackMap, by finding any piece with somewhere to go.
+//Only in check are the moves generated, stopping at the first legal one.
+bool	 HasAnyLegalMove(const Position& position);
+
+//NORMAL, CHECK, CHECKMATE or STALEMATE for the side to move.
+GAMESTATE GetGameState(const Position& position);
+
+//--------------------------------------------------------------------------------------------------
+
+#endif //_CHESS_MOVEGENERATOR_H
@@ -0,0 +1,67 @@
+//------------------------------------------------------------------------
+//  Fixed-capacity list of moves that lives on the stack.
+//------------------------------------------------------------------------
+
+#ifndef _CHESS_MOVELIST_H
+#define _CHESS_MOVELIST_H
+
+#include "ChessCommons.h"
+#include "ChessConstants.h"
+#include <utility>
+using namespace std;
+
+//--------------------------------------------------------------------------------------------------
+
+//Sized for any position, so generating moves never touches the heap. Ordering scores are kept
+//beside the moves rather than in them, so the moves themselves pack into a few cache lines.
+class MoveList
+{
+//--------------------------------------------------------------------------------------------------
+public:
+	MoveList()									{ mSize = 0; }
+
+	void		Add(const Move& move)			{ mMoves[mSize++] = move; }
+	void		Clear()							{ mSize = 0; }
+	void		Resize(int size)				{ if(size < mSize) mSize = size; }	//Only ever shrinks.
+
+	int			Size() const					{ return mSize; }
+	bool		Empty() const					{ return mSize == 0; }
+
+	Move&		operator[](int index)			{ return mMoves[index]; }
+	const Move& operator[](int index) const		{ return mMoves[index]; }
+
+	int&		Score(int index)				{ return mScores[index]; }
+	int			Score(int index) const			{ return mScores[index]; }
+
+	//Swaps two moves along with their scores.
+	void		Swap(int first, int second)
+	{
+		swap(mMoves[first], mMoves[second]);
+		swap(mScores[first], mScores[second]);
+	}
+
+	//Insertion sort - Moves with equal scores keep their order.
+	void		SortByScore(bool highToLow)
+	{
+		for(int index = 1; index < mSize; index++)
+		{
+			for(int slot = index; slot > 0 && (highToLow ? mScores[slot] > mScores[slot - 1] : mScores[slot] < mScores[slot - 1]); slot--)
+				Swap(slot, slot - 1);
+		}
+	}
+
+	Move*		begin()							{ return mMoves; }
+	Move*		end()							{ return mMoves + mSize; }
+	const Move* begin() const					{ return mMoves; }
+	const Move* end() const						{ return mMoves + mSize; }
+
+//--------------------------------------------------------------------------------------------------
+private:
+	Move mMoves[kMaxMovesPerPosition];
+	int	 mScores[kMaxMovesPerPosition];		//Only set by whoever orders the moves.
+	int	 mSize;
+};
+
+//--------------------------------------------------------------------------------------------------
+
+#endif //_CHESS_MOVELIST_H
@@ -4,6 +4,9 @@
 
 #include "ChessMoveManager.h"
 #include "ChessCommons.h"
+#include "ChessConstants.h"
+#include "ChessNotation.h"
+#include "ChessPosition.h"
 #include <iostream>
 #include <string>
 using namespace std;
@@ -13,14 +16,65 @@ MoveManager* MoveManager::mInstance = NULL;
 
 //--------------------------------------------------------------------------------------------------
 
+namespace
+{
+	void OutputGameStateText(GAMESTATE gameState, COLOUR playerTurn)
+	{
+		switch(gameState)
+		{
+			case GAMESTATE_NORMAL:
+			break;
+
+			case GAMESTATE_CHECK:
+				if(playerTurn == COLOUR_WHITE)
+					cout << " (WHITE in Check)";
+				else if(playerTurn == COLOUR_BLACK)
+					cout << " (BLACK in Check)";
+			break;
+
+			case GAMESTATE_CHECKMATE:
+				if(playerTurn == COLOUR_WHITE)
+				{
+					cout << " (WHITE in Checkmate)" << endl << "----------" << endl;
+					cout << "BLACK Wins" << endl << "----------" << endl;
+				}
+				else if(playerTurn == COLOUR_BLACK)
+				{
+					cout << " (BLACK in Checkmate)" << endl << "----------" << endl;
+					cout << "WHITE Wins" << endl << "----------" << endl;
+				}
+			break;
+
+			case GAMESTATE_STALEMATE:
+				cout << "(Stalemate)" << endl << "----------" << endl;
+			break;
+		}
+	}
+}
+
+//--------------------------------------------------------------------------------------------------
+
 MoveManager::MoveManager()
 {
+	mRecordedMoves.reserve(kMaxGamePly);
+	mPendingOutput.reserve(kMaxGamePly);
+	mStopOutput = false;
+
+	mOutputThread = thread(&MoveManager::RunOutput, this);
 }
 
 //--------------------------------------------------------------------------------------------------
 
 MoveManager::~MoveManager()
 {
+	//Let the output thread write whatever is still queued before it goes.
+	{
+		lock_guard<mutex> lock(mOutputMutex);
+		mStopOutput = true;
+	}
+	mOutputReady.notify_one();
+	mOutputThread.join();
+
 	mInstance = NULL;
 }
 
@@ -38,114 +92,131 @@ MoveManager* MoveManager::Instance()
 
 //--------------------------------------------------------------------------------------------------
 
-void MoveManager::ClearRecordedMoves()
+void MoveManager::Shutdown()
 {
-	mRecordedChessMoves.clear();
+	//The destructor drains and joins the output thread.
+	delete mInstance;
 }
 
 //--------------------------------------------------------------------------------------------------
 
-void MoveManager::StoreMove(SDL_Point fromBoardPosition, SDL_Point toBoardPosition)
+void MoveManager::ClearRecordedMoves()
 {
-	StoreMove(Move(fromBoardPosition, toBoardPosition));
+	mRecordedMoves.clear();
+
+	OutputEntry entry;
+	entry.type = OutputEntry::NEW_GAME;
+	QueueOutput(entry);
 }
 
 //--------------------------------------------------------------------------------------------------
 
 void MoveManager::StoreMove(Move move)
 {
-	//Convert the positions passed in as moves and store in mRecordedChessMoves.
-	ChessMove newMove;
-	string fromMove = ConvertBoardPositionIntToLetter(move.from_X);
-	fromMove += to_string(move.from_Y+1);
+	mRecordedMoves.push_back(move);
 
-	string toMove = ConvertBoardPositionIntToLetter(move.to_X);
-	toMove += to_string(move.to_Y+1);
+	OutputEntry entry;
+	entry.type = OutputEntry::MOVE;
+	entry.move = move;
+	QueueOutput(entry);
+}
 
-	newMove.startPosition = fromMove;
-	newMove.endPosition   = toMove;
+//--------------------------------------------------------------------------------------------------
 
-	//We still want the original move stored.
-	newMove.theMove = move;
+bool MoveManager::HasRecordedMoves()
+{
+	return mRecordedMoves.size() > 0;
+}
 
-	//Now do the recording.
-	mRecordedChessMoves.push_back(newMove);
+//--------------------------------------------------------------------------------------------------
 
-	OutputMove(newMove);
+Move MoveManager::GetLastMove()
+{
+	return mRecordedMoves.back();
 }
 
 //--------------------------------------------------------------------------------------------------
 
-bool MoveManager::HasRecordedMoves()
+void MoveManager::OutputGameState(GAMESTATE gameState, COLOUR playerTurn)
 {
-	return mRecordedChessMoves.size() > 0;
+	OutputEntry entry;
+	entry.type		 = OutputEntry::GAME_STATE;
+	entry.gameState	 = gameState;
+	entry.playerTurn = playerTurn;
+	QueueOutput(entry);
 }
 
 //--------------------------------------------------------------------------------------------------
 
-Move MoveManager::GetLastMove()
+void MoveManager::OutputText(const string& text)
 {
-	ChessMove chessMove = mRecordedChessMoves[mRecordedChessMoves.size()-1];
-	return chessMove.theMove;
+	OutputEntry entry;
+	entry.type = OutputEntry::TEXT;
+	entry.text = text;
+	QueueOutput(entry);
 }
 
 //--------------------------------------------------------------------------------------------------
 
-string MoveManager::ConvertBoardPositionIntToLetter(int numericalValue)
+void MoveManager::QueueOutput(const OutputEntry& entry)
 {
-	switch(numericalValue)
 	{
-		case 0:	return "A";	break;
-		case 1:	return "B";	break;
-		case 2:	return "C";	break;
-		case 3:	return "D";	break;
-		case 4:	return "E";	break;
-		case 5:	return "F";	break;
-		case 6:	return "G";	break;
-		case 7:	return "H";	break;
-		default: return "X"; break;
+		lock_guard<mutex> lock(mOutputMutex);
+		mPendingOutput.push_back(entry);
 	}
+	mOutputReady.notify_one();
 }
 
 //--------------------------------------------------------------------------------------------------
 
-void MoveManager::OutputMove(ChessMove move)
+void MoveManager::RunOutput()
 {
-	cout << endl << move.startPosition << " -> " << move.endPosition;
-}
+	//The game played again on a position of our own, which SAN needs to tell moves apart.
+	Board	 startBoard;
+	Position position(startBoard);
 
-//--------------------------------------------------------------------------------------------------
+	//Swapped with the queue, so neither side allocates once both have grown to a game's length.
+	vector<OutputEntry> entries;
+	entries.reserve(kMaxGamePly);
 
-void MoveManager::OutputGameState(GAMESTATE gameState, COLOUR playerTurn)
-{
-	switch(gameState)
+	while(true)
 	{
-		case GAMESTATE_NORMAL:
-		break;
-
-		case GAMESTATE_CHECK:
-			if(playerTurn == COLOUR_WHITE)
-				cout << " (WHITE in Check)";
-			else if(playerTurn == COLOUR_BLACK)
-				cout << " (BLACK in Check)";
-		break;
-
-		case GAMESTATE_CHECKMATE:
-			if(playerTurn == COLOUR_WHITE)
-			{
-				cout << " (WHITE in Checkmate)" << endl << "----------" << endl;
-				cout << "BLACK Wins" << endl << "----------" << endl;
-			}
-			else if(playerTurn == COLOUR_BLACK)
+		{
+			unique_lock<mutex> lock(mOutputMutex);
+			mOutputReady.wait(lock, [this]() { return mStopOutput || !mPendingOutput.empty(); });
+
+			if(mPendingOutput.empty())
+				return;
+
+			entries.swap(mPendingOutput);
+		}
+
+		for(const OutputEntry& entry : entries)
+		{
+			switch(entry.type)
 			{
-				cout << " (BLACK in Checkmate)" << endl << "----------" << endl;
-				cout << "WHITE Wins" << endl << "----------" << endl;
+				case OutputEntry::NEW_GAME:
+					position = Position(startBoard);
+					cout << endl << "----------" << endl << "New Game" << endl << "----------" << endl;
+				break;
+
+				case OutputEntry::MOVE:
+					cout << endl << position.fullmoveNumber << (position.sideToMove == COLOUR_WHITE ? ". " : "... ") << MoveToSAN(position, entry.move);
+					position.MakeMove(entry.move);
+				break;
+
+				case OutputEntry::GAME_STATE:
+					OutputGameStateText(entry.gameState, entry.playerTurn);
+				break;
+
+				case OutputEntry::TEXT:
+					cout << entry.text;
+				break;
 			}
-		break;
+		}
 
-		case GAMESTATE_STALEMATE:
-			cout << "(Stalemate)" << endl << "----------" << endl;
-		break;
+		cout.flush();
+		entries.clear();
 	}
 }
 
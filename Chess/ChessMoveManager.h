@@ -5,13 +5,18 @@
 #ifndef _CHESS_MOVEMANAGER_H
 #define _CHESS_MOVEMANAGER_H
 
-#include "sdl_game.h"
 #include "ChessCommons.h"
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
 #include <vector>
 using namespace std;
 
 //--------------------------------------------------------------------------------------------------
 
+//The moves of the game being played, as the players made them. Recording only appends a Move -
+//Writing it out as notation is left to a thread of its own, so a turn never waits on the console.
 class MoveManager
 {
 //--------------------------------------------------------------------------------------------------
@@ -20,9 +25,13 @@ public:
 
 	static MoveManager* Instance();
 
+	//Writes out everything still queued, then stops the output thread. Call before exiting, or the
+	//last moves can be lost.
+	static void Shutdown();
+
 	void ClearRecordedMoves();
 
-	void StoreMove(SDL_Point fromBoardPosition, SDL_Point toBoardPosition);
+	//The move as played, with any promotion filled in. It must be legal on the game's board.
 	void StoreMove(Move move);
 
 	bool HasRecordedMoves();
@@ -30,17 +39,45 @@ public:
 
 	void OutputGameState(GAMESTATE gameState, COLOUR playerTurn);
 
+	//Anything else for the console, written in turn with the moves. Safe to call from any thread.
+	void OutputText(const string& text);
+
 //--------------------------------------------------------------------------------------------------
 private:
 	MoveManager();
-	string ConvertBoardPositionIntToLetter(int numericalValue);
-	void   OutputMove(ChessMove move);
+
+	//What the output thread has still to write, in the order it happened.
+	struct OutputEntry
+	{
+		enum TYPE
+		{
+			NEW_GAME,
+			MOVE,
+			GAME_STATE,
+			TEXT
+		};
+
+		TYPE	  type;
+		Move	  move;
+		GAMESTATE gameState;
+		COLOUR	  playerTurn;
+		string	  text;
+	};
+
+	void QueueOutput(const OutputEntry& entry);
+	void RunOutput();
 
 //--------------------------------------------------------------------------------------------------
 private:
 	static MoveManager* mInstance;
 
-	vector<ChessMove> mRecordedChessMoves;
+	vector<Move>		mRecordedMoves;			//Reserved for a whole game up front.
+
+	thread				mOutputThread;
+	mutex				mOutputMutex;
+	condition_variable	mOutputReady;
+	vector<OutputEntry> mPendingOutput;
+	bool				mStopOutput;
 };
 
 //--------------------------------------------------------------------------------------------------
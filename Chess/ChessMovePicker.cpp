@@ -0,0 +1,263 @@
+//------------------------------------------------------------------------
+//  Staged move ordering - Hands out the moves most likely to cause a
+//  cutoff first, and only generates or sorts what is actually asked for.
+//------------------------------------------------------------------------
+
+#include "ChessMovePicker.h"
+#include "ChessEvaluation.h"
+#include "ChessMoveGenerator.h"
+
+//--------------------------------------------------------------------------------------------------
+
+//Capture ordering, indexed [attacker][victim] - Most valuable victim first, cheapest attacker breaking ties.
+const int MVVLVA[6][6] = {
+
+	{ 105, 205, 305, 405, 505, 1005 },
+	{ 104, 204, 304, 404, 504, 1004 },
+	{ 103, 203, 303, 403, 503, 1003 },
+	{ 102, 202, 302, 402, 502, 1002 },
+	{ 101, 201, 301, 401, 501, 1001 },
+	{ 100, 200, 300, 400, 500, 1000 }
+};
+
+//--------------------------------------------------------------------------------------------------
+
+MovePicker::MovePicker(const Position& position, const HistoryTable& history, const Move* pvMove, const Move* hashMove, const Move* killers, bool capturesOnly)
+	: mPosition(position), mHistory(history)
+{
+	mStage			 = PICK_PV_MOVE;
+	mCapturesOnly	 = capturesOnly;
+	mNextIndex		 = 0;
+	mCaptureCount	 = 0;
+	mBadCaptureIndex = 0;
+
+	//Moves from elsewhere in the tree, or from another position with the same hash, may not even
+	//be possible here.
+	mHasPVMove	 = pvMove != nullptr && IsPseudoLegalMove(position, *pvMove);
+	mHasHashMove = hashMove != nullptr && IsPseudoLegalMove(position, *hashMove) && !(mHasPVMove && *hashMove == *pvMove);
+	if (mHasPVMove)
+	{
+		mPVMove = *pvMove;
+	}
+	if (mHasHashMove)
+	{
+		mHashMove = *hashMove;
+	}
+
+	//Killers are only checked when their turn comes, as most nodes never get that far.
+	mKillerIndex = 0;
+	for (int killer = 0; killer < kKillersPerPly; killer++)
+	{
+		mKillerPicked[killer] = false;
+		if (killers != nullptr && !capturesOnly)
+		{
+			mKillers[killer] = killers[killer];
+		}
+	}
+	mKillerCount = killers != nullptr && !capturesOnly ? kKillersPerPly : 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+bool MovePicker::NextMove(Move* move)
+{
+	while (true)
+	{
+		switch (mStage)
+		{
+			case PICK_PV_MOVE:
+				mStage = PICK_HASH_MOVE;
+				if (mHasPVMove)
+				{
+					*move = mPVMove;
+					return true;
+				}
+				break;
+
+			case PICK_HASH_MOVE:
+				mStage = PICK_GENERATE_CAPTURES;
+				if (mHasHashMove)
+				{
+					*move = mHashMove;
+					return true;
+				}
+				break;
+
+			case PICK_GENERATE_CAPTURES:
+				GeneratePseudoLegalCaptures(mPosition, &mMoves);
+				for (int index = 0; index < mMoves.Size(); index++)
+				{
+					mMoves.Score(index) = ScoreCapture(mPosition, mMoves[index]);
+				}
+				mCaptureCount = mMoves.Size();
+				mNextIndex	  = 0;
+				mStage		  = PICK_GOOD_CAPTURES;
+				break;
+
+			case PICK_GOOD_CAPTURES:
+				while (PickBest(mCaptureCount, move))
+				{
+					//The rest may lose material, so they wait until after the quiet moves.
+					if (mMoves.Score(mNextIndex) < kGoodCaptureScore)
+					{
+						break;
+					}
+
+					mNextIndex++;
+					if (!IsAlreadyPicked(*move))
+					{
+						return true;
+					}
+				}
+				mBadCaptureIndex = mNextIndex;
+				mStage			 = mCapturesOnly ? PICK_BAD_CAPTURES : PICK_KILLERS;
+				break;
+
+			case PICK_KILLERS:
+				while (mKillerIndex < mKillerCount)
+				{
+					int			killer	  = mKillerIndex++;
+					const Move& candidate = mKillers[killer];
+
+					//A killer from a sibling may be a capture here, or already tried.
+					if (IsPseudoLegalMove(mPosition, candidate) && IsQuietMove(mPosition, candidate) && !IsAlreadyPicked(candidate))
+					{
+						mKillerPicked[killer] = true;
+						*move				  = candidate;
+						return true;
+					}
+				}
+				mStage = PICK_GENERATE_QUIETS;
+				break;
+
+			case PICK_GENERATE_QUIETS:
+				GeneratePseudoLegalQuiets(mPosition, &mMoves);
+				for (int index = mCaptureCount; index < mMoves.Size(); index++)
+				{
+					const Move& quiet	 = mMoves[index];
+					mMoves.Score(index) = mHistory[mPosition.sideToMove][MoveFromSquare(quiet)][MoveToSquare(quiet)];
+				}
+				mNextIndex = mCaptureCount;
+				mStage	   = PICK_QUIETS;
+				break;
+
+			case PICK_QUIETS:
+				while (PickBest(mMoves.Size(), move))
+				{
+					mNextIndex++;
+					if (!IsAlreadyPicked(*move))
+					{
+						return true;
+					}
+				}
+				mNextIndex = mBadCaptureIndex;
+				mStage	   = PICK_BAD_CAPTURES;
+				break;
+
+			case PICK_BAD_CAPTURES:
+				while (PickBest(mCaptureCount, move))
+				{
+					mNextIndex++;
+					if (!IsAlreadyPicked(*move))
+					{
+						return true;
+					}
+				}
+				mStage = PICK_DONE;
+				break;
+
+			case PICK_DONE:
+				return false;
+		}
+	}
+}
+
+//--------------------------------------------------------------------------------------------------
+
+int MovePicker::ScoreCapture(const Position& position, const Move& move)
+{
+	PIECE victim   = position.PieceOn(MoveToSquare(move));
+	PIECE attacker = position.PieceOn(MoveFromSquare(move));
+
+	//En'passant lands on an empty square but still takes a pawn.
+	if (victim == PIECE_NONE && attacker == PIECE_PAWN && MoveToSquare(move) == position.enPassantSquare)
+	{
+		victim = PIECE_PAWN;
+	}
+
+	int score = victim != PIECE_NONE ? MVVLVA[attacker][victim] : 0;
+
+	//A queen promotion is worth about as much as taking a queen. Promoting to anything less is
+	//rarely right, so those wait with the losing captures.
+	if (move.Promotion() == PIECE_QUEEN)
+	{
+		return kGoodCaptureScore + score + MVVLVA[PIECE_PAWN][PIECE_QUEEN];
+	}
+
+	//Taking something worth at least the attacker cannot lose material. The king can only take
+	//undefended pieces, so its captures are always safe.
+	if (victim != PIECE_NONE && move.Promotion() == PIECE_NONE &&
+		(attacker == PIECE_KING || kMiddlegamePieceScores[victim] >= kMiddlegamePieceScores[attacker]))
+	{
+		return kGoodCaptureScore + score;
+	}
+
+	return score;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+bool MovePicker::IsQuietMove(const Position& position, const Move& move)
+{
+	int toSquare = MoveToSquare(move);
+	if (position.PieceOn(toSquare) != PIECE_NONE || move.Promotion() != PIECE_NONE)
+	{
+		return false;
+	}
+
+	return !(toSquare == position.enPassantSquare && position.PieceOn(MoveFromSquare(move)) == PIECE_PAWN);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+bool MovePicker::IsAlreadyPicked(const Move& move) const
+{
+	if ((mHasPVMove && move == mPVMove) || (mHasHashMove && move == mHashMove))
+	{
+		return true;
+	}
+
+	for (int killer = 0; killer < kKillersPerPly; killer++)
+	{
+		if (mKillerPicked[killer] && move == mKillers[killer])
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+bool MovePicker::PickBest(int end, Move* move)
+{
+	if (mNextIndex >= end)
+	{
+		return false;
+	}
+
+	int best = mNextIndex;
+	for (int index = mNextIndex + 1; index < end; index++)
+	{
+		if (mMoves.Score(index) > mMoves.Score(best))
+		{
+			best = index;
+		}
+	}
+
+	mMoves.Swap(mNextIndex, best);
+	*move = mMoves[mNextIndex];
+	return true;
+}
+
+//--------------------------------------------------------------------------------------------------
@@ -0,0 +1,89 @@
+//------------------------------------------------------------------------
+//  Staged move ordering - Hands out the moves most likely to cause a
+//  cutoff first, and only generates or sorts what is actually asked for.
+//------------------------------------------------------------------------
+
+#ifndef _CHESS_MOVEPICKER_H
+#define _CHESS_MOVEPICKER_H
+
+#include "ChessMoveList.h"
+#include "ChessPosition.h"
+
+//--------------------------------------------------------------------------------------------------
+
+//Quiet moves that caused a cutoff at each ply of the current search.
+const int kKillersPerPly = 2;
+
+//How often each quiet move has caused a cutoff, weighted by depth. Indexed [COLOUR][from][to].
+typedef int HistoryTable[2][64][64];
+
+//--------------------------------------------------------------------------------------------------
+
+enum PICK_STAGE
+{
+	PICK_PV_MOVE,
+	PICK_HASH_MOVE,
+	PICK_GENERATE_CAPTURES,
+	PICK_GOOD_CAPTURES,
+	PICK_KILLERS,
+	PICK_GENERATE_QUIETS,
+	PICK_QUIETS,
+	PICK_BAD_CAPTURES,
+	PICK_DONE
+};
+
+//--------------------------------------------------------------------------------------------------
+
+class MovePicker
+{
+//--------------------------------------------------------------------------------------------------
+public:
+	//Any of the moves may be nullptr. Captures only skips the killers and quiet moves, for the
+	//quiescence search.
+	MovePicker(const Position& position, const HistoryTable& history, const Move* pvMove, const Move* hashMove, const Move* killers, bool capturesOnly = false);
+
+	//The next pseudo-legal move, best first. Returns false once every move has been handed out.
+	bool NextMove(Move* move);
+
+	//Most valuable victim, least valuable attacker. Captures that cannot lose material score above
+	//kGoodCaptureScore, the rest below it.
+	static int ScoreCapture(const Position& position, const Move& move);
+	static bool IsQuietMove(const Position& position, const Move& move);
+
+	static const int kGoodCaptureScore = 1 << 20;
+
+//--------------------------------------------------------------------------------------------------
+private:
+	bool IsAlreadyPicked(const Move& move) const;
+
+	//Selection rather than a full sort - Most nodes cut off after a move or two. Swaps the best move
+	//before end into the next slot and copies it out, but leaves the caller to step past it.
+	bool PickBest(int end, Move* move);
+
+//--------------------------------------------------------------------------------------------------
+private:
+	const Position&		mPosition;
+	const HistoryTable& mHistory;
+	PICK_STAGE			mStage;
+	bool				mCapturesOnly;
+
+	//Moves tried before anything is generated. Only valid ones are kept.
+	Move				mPVMove;
+	Move				mHashMove;
+	Move				mKillers[kKillersPerPly];
+	bool				mKillerPicked[kKillersPerPly];
+	bool				mHasPVMove;
+	bool				mHasHashMove;
+	int					mKillerCount;
+	int					mKillerIndex;
+
+	//Captures first, then quiet moves added behind them.
+	MoveList			mMoves;
+	int					mNextIndex;
+	int					mCaptureCount;
+	int					mBadCaptureIndex;		//First of the captures left over for the last stage.
+};
+
+//--------------------------------------------------------------------------------------------------
+
+#endif //_CHESS_MOVEPICKER_H
@@ -0,0 +1,213 @@
+//------------------------------------------------------------------------
+//  Standard Algebraic Notation - How moves are written in books, PGN
+//  files and test suites.
+//------------------------------------------------------------------------
+
+#include "ChessNotation.h"
+#include "ChessMoveGenerator.h"
+
+//--------------------------------------------------------------------------------------------------
+
+namespace
+{
+	const string kPieceLetters = "PNBRQK";		//In PIECE order.
+
+	string SquareToString(int square)
+	{
+		string text;
+		text += (char)('a' + FileOfSquare(square));
+		text += (char)('1' + RankOfSquare(square));
+		return text;
+	}
+
+	bool IsCastling(const Position& position, const Move& move)
+	{
+		int fromSquare = MoveFromSquare(move);
+		int toSquare   = MoveToSquare(move);
+		return position.PieceOn(fromSquare) == PIECE_KING && (toSquare - fromSquare == 2 || fromSquare - toSquare == 2);
+	}
+}
+
+//--------------------------------------------------------------------------------------------------
+
+string MoveToSAN(Position& position, const Move& move)
+{
+	int	  fromSquare = MoveFromSquare(move);
+	int	  toSquare	 = MoveToSquare(move);
+	PIECE moving	 = position.PieceOn(fromSquare);
+	bool  isCapture	 = position.PieceOn(toSquare) != PIECE_NONE || (moving == PIECE_PAWN && toSquare == position.enPassantSquare);
+
+	string text;
+	if(IsCastling(position, move))
+	{
+		text = toSquare > fromSquare ? "O-O" : "O-O-O";
+	}
+	else if(moving == PIECE_PAWN)
+	{
+		if(isCapture)
+			text += (char)('a' + FileOfSquare(fromSquare));
+	}
+	else
+	{
+		text += kPieceLetters[moving];
+
+		//Name as much of the starting square as it takes to tell the move apart from any other
+		//piece of the same kind that can also get there - the file if that is enough, else the rank.
+		MoveList legalMoves;
+		GenerateMoves(position, &legalMoves);
+
+		bool ambiguous	= false;
+		bool sharedFile = false;
+		bool sharedRank = false;
+		for(const Move& other : legalMoves)
+		{
+			int otherFromSquare = MoveFromSquare(other);
+			if(otherFromSquare == fromSquare || MoveToSquare(other) != toSquare || position.PieceOn(otherFromSquare) != moving)
+				continue;
+
+			ambiguous	= true;
+			sharedFile |= FileOfSquare(otherFromSquare) == FileOfSquare(fromSquare);
+			sharedRank |= RankOfSquare(otherFromSquare) == RankOfSquare(fromSquare);
+		}
+
+		if(ambiguous && (!sharedFile || sharedRank))
+			text += (char)('a' + FileOfSquare(fromSquare));
+		if(ambiguous && sharedFile)
+			text += (char)('1' + RankOfSquare(fromSquare));
+	}
+
+	if(text[0] != 'O')
+	{
+		if(isCapture)
+			text += 'x';
+		text += SquareToString(toSquare);
+
+		if(move.Promotion() != PIECE_NONE)
+		{
+			text += '=';
+			text += kPieceLetters[move.Promotion()];
+		}
+	}
+
+	position.MakeMove(move);
+	GAMESTATE state = GetGameState(position);
+	if(state == GAMESTATE_CHECK)
+		text += '+';
+	else if(state == GAMESTATE_CHECKMATE)
+		text += '#';
+	position.UnMakeMove();
+
+	return text;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+bool MoveFromSAN(const Position& position, const string& text, Move* move)
+{
+	//Check marks and annotations say nothing about which move it is.
+	string san = text;
+	while(!san.empty() && string("+#!?").find(san.back()) != string::npos)
+		san.pop_back();
+	if(san.empty())
+		return false;
+
+	MoveList legalMoves;
+	GenerateMoves(position, &legalMoves);
+
+	//Castling, with letter O or zero.
+	if(san == "O-O" || san == "0-0" || san == "O-O-O" || san == "0-0-0")
+	{
+		bool kingside = san.size() == 3;
+		for(const Move& legalMove : legalMoves)
+		{
+			if(IsCastling(position, legalMove) && (MoveToSquare(legalMove) > MoveFromSquare(legalMove)) == kingside)
+			{
+				*move = legalMove;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	//Coordinate notation, as UCI writes it.
+	for(const Move& legalMove : legalMoves)
+	{
+		if(MoveToString(legalMove) == san)
+		{
+			*move = legalMove;
+			return true;
+		}
+	}
+
+	//The piece, if it isn't a pawn. Lower case b is always a file.
+	PIECE  moving = PIECE_PAWN;
+	size_t start  = 0;
+	if(kPieceLetters.find(san[0]) != string::npos && san[0] != 'P')
+	{
+		moving = (PIECE)kPieceLetters.find(san[0]);
+		start  = 1;
+	}
+
+	//The promotion, written "e8=Q" or just "e8Q".
+	PIECE promotion = PIECE_NONE;
+	if(san.size() >= 2 && kPieceLetters.find((char)toupper(san.back())) != string::npos && isdigit(san[san.size() - 2]))
+	{
+		promotion = (PIECE)kPieceLetters.find((char)toupper(san.back()));
+		san.pop_back();
+	}
+	else if(san.size() >= 3 && san[san.size() - 2] == '=' && kPieceLetters.find((char)toupper(san.back())) != string::npos)
+	{
+		promotion = (PIECE)kPieceLetters.find((char)toupper(san.back()));
+		san.resize(san.size() - 2);
+	}
+	if(!san.empty() && san.back() == '=')
+		san.pop_back();
+
+	//The destination ends the move. Whatever is left between it and the piece narrows down where
+	//it came from.
+	if(san.size() < start + 2)
+		return false;
+
+	char toFile = san[san.size() - 2];
+	char toRank = san[san.size() - 1];
+	if(toFile < 'a' || toFile > 'h' || toRank < '1' || toRank > '8')
+		return false;
+	int toSquare = (toRank - '1') * 8 + (toFile - 'a');
+
+	int fromFile = -1;
+	int fromRank = -1;
+	for(size_t index = start; index < san.size() - 2; index++)
+	{
+		char symbol = san[index];
+		if(symbol >= 'a' && symbol <= 'h')
+			fromFile = symbol - 'a';
+		else if(symbol >= '1' && symbol <= '8')
+			fromRank = symbol - '1';
+		else if(symbol != 'x' && symbol != ':' && symbol != '-')
+			return false;
+	}
+
+	int matches = 0;
+	for(const Move& legalMove : legalMoves)
+	{
+		int fromSquare = MoveFromSquare(legalMove);
+		if(MoveToSquare(legalMove) != toSquare || position.PieceOn(fromSquare) != moving || IsCastling(position, legalMove))
+			continue;
+		if((fromFile >= 0 && FileOfSquare(fromSquare) != fromFile) || (fromRank >= 0 && RankOfSquare(fromSquare) != fromRank))
+			continue;
+
+		//A promotion that doesn't name its piece is to a queen.
+		PIECE wanted = promotion;
+		if(wanted == PIECE_NONE && legalMove.Promotion() != PIECE_NONE)
+			wanted = PIECE_QUEEN;
+		if(legalMove.Promotion() != wanted)
+			continue;
+
+		*move = legalMove;
+		matches++;
+	}
+
+	return matches == 1;
+}
+
+//--------------------------------------------------------------------------------------------------
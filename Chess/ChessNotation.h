@@ -0,0 +1,27 @@
+//------------------------------------------------------------------------
+//  Standard Algebraic Notation - How moves are written in books, PGN
+//  files and test suites.
+//------------------------------------------------------------------------
+
+#ifndef _CHESS_NOTATION_H
+#define _CHESS_NOTATION_H
+
+#include "ChessCommons.h"
+#include "ChessPosition.h"
+#include <string>
+using namespace std;
+
+//--------------------------------------------------------------------------------------------------
+
+//e.g. "Nbd7", "exd5", "O-O" or "e8=Q+". The move must be legal. It is made and unmade on the
+//position to see whether it checks or mates.
+string MoveToSAN(Position& position, const Move& move);
+
+//Reads SAN as loosely as GUIs and test suites write it - Check marks, annotations, "0-0" and a
+//missing "=" are all accepted, as is coordinate notation. Returns false unless exactly one legal
+//move matches.
+bool   MoveFromSAN(const Position& position, const string& text, Move* move);
+
+//--------------------------------------------------------------------------------------------------
+
+#endif //_CHESS_NOTATION_H
@@ -0,0 +1,73 @@
+//------------------------------------------------------------------------
+//  Opening book - Polyglot layout .bin files, memory-mapped and binary
+//  searched, so known openings are played without searching at all.
+//------------------------------------------------------------------------
+
+#ifndef _CHESS_OPENINGBOOK_H
+#define _CHESS_OPENINGBOOK_H
+
+#include "ChessCommons.h"
+#include "ChessMappedFile.h"
+#include "ChessMoveList.h"
+#include "ChessPosition.h"
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+using namespace std;
+
+//--------------------------------------------------------------------------------------------------
+
+//One move the book knows for a position. Weights are relative to the position's other entries.
+struct BookEntry
+{
+	uint64_t key;
+	Move	 move;
+	int		 weight;
+};
+
+//--------------------------------------------------------------------------------------------------
+
+class OpeningBook
+{
+//--------------------------------------------------------------------------------------------------
+public:
+	OpeningBook();
+
+	//Maps the whole file into memory. Returns false, leaving no book open, if it is missing or
+	//not a whole number of entries.
+	bool	 Open(const string& path);
+	void	 Close();
+	bool	 IsOpen() const						{ return mEntries != nullptr; }
+	size_t	 GetEntryCount() const				{ return mEntryCount; }
+
+	//Every legal move the book holds for the position, in file order.
+	void	 GetEntries(const Position& position, vector<BookEntry>* entries) const;
+
+	//Picks one of the position's book moves at random, more often the heavier it is weighted.
+	//Returns false once the game has left the book.
+	bool	 PickMove(const Position& position, Move* move);
+
+	//Entries are sorted by Polyglot's own key, so any Polyglot book can be read. It is not
+	//Position::key, whose numbers are the engine's own and may change.
+	static uint64_t BookKey(const Position& position);
+
+	//Sorts the entries and writes them in the same layout Open reads.
+	static bool Save(const string& path, vector<BookEntry> entries);
+
+//--------------------------------------------------------------------------------------------------
+private:
+	uint64_t EntryKey(size_t index) const;
+	bool	 DecodeEntry(const Position& position, const MoveList& legalMoves, size_t index, BookEntry* entry) const;
+
+//--------------------------------------------------------------------------------------------------
+private:
+	MappedFile			 mFile;
+	const unsigned char* mEntries;			//The mapped file - 16 bytes per entry, big-endian.
+	size_t				 mEntryCount;
+	mt19937_64			 mRandom;
+};
+
+//--------------------------------------------------------------------------------------------------
+
+#endif //_CHESS_OPENINGBOOK_H
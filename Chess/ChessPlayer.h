@@ -6,7 +6,8 @@
 #define _CHESSPLAYER_H
 
 #include "ChessCommons.h"
-#include <SDL.h>
+#include "ChessMoveList.h"
+#include "sdl_game.h"
 #include <vector>
 using namespace::std;
 
@@ -17,7 +18,7 @@ class ChessPlayer
 //--------------------------------------------------------------------------------------------------
 public:
 	ChessPlayer(sdl_game::app_context & context, COLOUR colour, Board* board, vector<SDL_Point>* highlights, SDL_Point* selectedPiecePosition, Move* lastMove);
-	~ChessPlayer();
+	virtual ~ChessPlayer();
 
 	COLOUR	 GetColour()			{return mTeamColour;}
 	MOVETYPE GetMoveType()			{return mCurrentMove;}
@@ -27,6 +28,8 @@ public:
 	virtual GAMESTATE	PreTurn();
 	virtual bool		TakeATurn(SDL_Event e);
 	virtual void		EndTurn();
+	virtual void		CancelTurn();		//Abandons a turn in progress, e.g. when the game is reset.
+	virtual void		SearchDepthChanged()	{}	//Only a player that searches has anything to redo.
 
 	void				RenderPawnPromotion(sdl_game::app_context & context);
 
@@ -34,21 +37,8 @@ public:
 protected:
 	virtual bool MakeAMove(SDL_Point boardPosition);
 
-	void GetNumberOfLivingPieces();
-	void GetMoveOptions(SDL_Point piecePosition, BoardPiece boardPiece, Board boardToTest, vector<Move>* moves);
-	void GetAllMoveOptions(Board boardToTest, COLOUR teamColour, vector<Move>* moves);
-	bool CheckMoveOptionValidityAndStoreMove(Move moveToCheck, COLOUR pieceColour, Board boardToTest, vector<Move>* moves);
-
-	void GetPawnMoveOptions(SDL_Point piecePosition, BoardPiece boardPiece, Board boardToTest, vector<Move>* moves);
-	void GetHorizontalAndVerticalMoveOptions(SDL_Point piecePosition, BoardPiece boardPiece, Board boardToTest, vector<Move>* moves);
-	void GetDiagonalMoveOptions(SDL_Point piecePosition, BoardPiece boardPiece, Board boardToTest, vector<Move>* moves);
-	void GetKnightMoveOptions(SDL_Point piecePosition, BoardPiece boardPiece, Board boardToTest, vector<Move>* moves);
-	void GetKingMoveOptions(SDL_Point piecePosition, BoardPiece boardPiece, Board boardToTest, vector<Move>* moves);
-
-	void ClearEnPassant();
-	bool CheckForCheck(Board boardToTest, COLOUR teamColour);
-	bool CheckForCheckmate(Board boardToTest, COLOUR teamColour);
-	bool CheckForStalemate(Board boardToCheck, COLOUR teamColour);
+	void GetMoveOptions(SDL_Point piecePosition, const Board& boardToTest, MoveList* moves);
+	void GetAllMoveOptions(const Board& boardToTest, MoveList* moves);
 
 //--------------------------------------------------------------------------------------------------
 protected:
@@ -61,8 +51,6 @@ protected:
 	MOVETYPE		  mCurrentMove;
 	SDL_Point*		  mSelectedPiecePosition = nullptr;
 
-	int				  mNumberOfLivingPieces;
-
 	bool			  mInCheck;
 
 	Move*			  mLastMove;
@@ -2,6 +2,8 @@
 
 #include "ChessPlayer.h"
 #include "ChessCommons.h"
+#include "ChessOpeningBook.h"
+#include "ChessSearch.h"
 #include <SDL.h>
 
 class ChessPlayerAI : public ChessPlayer
@@ -12,30 +14,18 @@ public:
 	~ChessPlayerAI();
 
 	bool		TakeATurn(SDL_Event e);
+	void		CancelTurn();
+	void		SearchDepthChanged();
 
 //--------------------------------------------------------------------------------------------------
 protected:
-	int  MiniMax(Board board, int depth, Move* bestMove);
-	int  Maximise(Board board, int depth, Move* bestMove, int alpha, int beta);
-	int  Minimise(Board board, int depth, Move* bestMove, int alpha, int beta);
 	bool MakeAMove(Move* move, Board* board);
-	void UnMakeAMove(Move move, Board currentBoard);
-
-	void OrderMoves(Board board, vector<Move>* moves, bool highToLow);
-	void ValueMoves(Board board, vector<Move>* moves);
-	void CropMoves(vector<Move>* moves, unsigned int maxNumberOfMoves);
-
-	int  ScoreTheBoard(Board boardToScore);
-	int	 ScoreBoardPieces(Board boardToScore);
-	int  ScoreBoardPositioning(Board boardToScore);
-	int  GetPieceIndex(PIECE piece);
-	
-	bool IsGameOver(Board boardToCheck);
 
 private:
 	int* mDepthToSearch;
-	vector<Move> moves;
 	Move mBestMove;
 
-	COLOUR mOpponentColour;
+	SearchManager		 mSearchManager;	//Owns the search threads and their shared transposition table.
+	future<SearchResult> mPendingMove;		//Valid while a search for this turn is running or unclaimed.
+	OpeningBook			 mOpeningBook;		//Played from without searching until the game leaves it.
 };
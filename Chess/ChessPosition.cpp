@@ -0,0 +1,739 @@
+//------------------------------------------------------------------------
+//  Bitboard-backed position used by move generation, search and scoring.
+//------------------------------------------------------------------------
+
+#include "ChessPosition.h"
+#include <algorithm>
+#include <cstdlib>		//abs
+#include <sstream>
+
+//--------------------------------------------------------------------------------------------------
+
+namespace
+{
+	//Random numbers XORed into the key for each feature of a position.
+	struct ZobristKeys
+	{
+		uint64_t pieces[2][kNumberOfPieces][64];
+		uint64_t castling[16];				//Indexed by the CASTLING_RIGHTS flags directly.
+		uint64_t enPassantFile[8];
+		uint64_t blackToMove;
+	};
+
+	constexpr ZobristKeys GenerateZobristKeys()
+	{
+		ZobristKeys keys = {};
+
+		//SplitMix64 - Fixed seed so keys are identical from run to run.
+		uint64_t state = 0x9E3779B97F4A7C15ULL;
+		auto next = [&state]()
+		{
+			state += 0x9E3779B97F4A7C15ULL;
+			uint64_t value = state;
+			value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+			value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+			return value ^ (value >> 31);
+		};
+
+		for(int colour = 0; colour < 2; colour++)
+		{
+			for(int piece = 0; piece < kNumberOfPieces; piece++)
+			{
+				for(int square = 0; square < 64; square++)
+					keys.pieces[colour][piece][square] = next();
+			}
+		}
+
+		//No rights hashes to nothing, so an empty position has an empty key.
+		for(int rights = 1; rights < 16; rights++)
+			keys.castling[rights] = next();
+
+		for(int file = 0; file < 8; file++)
+			keys.enPassantFile[file] = next();
+
+		keys.blackToMove = next();
+		return keys;
+	}
+
+	constexpr ZobristKeys kZobristKeys = GenerateZobristKeys();
+
+	//----------------------------------------------------------------------------------------------
+
+	//Castling rights that survive a move touching each square. Moving a king or rook off its start
+	//square, or capturing a rook on it, removes the matching rights.
+	constexpr int CastlingRightsMask(int square)
+	{
+		switch(square)
+		{
+			case kSquareA1: return ~CASTLE_WHITE_QUEENSIDE;
+			case kSquareE1: return ~(CASTLE_WHITE_KINGSIDE | CASTLE_WHITE_QUEENSIDE);
+			case kSquareH1: return ~CASTLE_WHITE_KINGSIDE;
+			case kSquareA8: return ~CASTLE_BLACK_QUEENSIDE;
+			case kSquareE8: return ~(CASTLE_BLACK_KINGSIDE | CASTLE_BLACK_QUEENSIDE);
+			case kSquareH8: return ~CASTLE_BLACK_KINGSIDE;
+			default:		return ~CASTLE_NONE;
+		}
+	}
+}
+
+//--------------------------------------------------------------------------------------------------
+
+Position::Position()
+{
+	for(int colour = 0; colour < 2; colour++)
+	{
+		for(int piece = 0; piece < kNumberOfPieces; piece++)
+			pieces[colour][piece] = 0;
+	}
+
+	occupancy[COLOUR_WHITE] = 0;
+	occupancy[COLOUR_BLACK] = 0;
+	occupancy[COLOUR_NONE]	= 0;
+	sideToMove				= COLOUR_WHITE;
+	castlingRights			= CASTLE_NONE;
+	enPassantSquare			= kNoSquare;
+	halfmoveClock			= 0;
+	fullmoveNumber			= 1;
+	key						= 0;
+	eval					= EvalAccumulator();
+	hasAttackMap			= false;
+
+	//Reserve once up front so making moves never allocates.
+	undoStack.reserve(kMaxGamePly);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+Position::Position(const Board& board)
+	: Position()
+{
+	sideToMove = board.sideToMove;
+
+	for(int x = 0; x < kBoardDimensions; x++)
+	{
+		for(int y = 0; y < kBoardDimensions; y++)
+		{
+			const BoardPiece& boardPiece = board.currentLayout[x][y];
+			if(boardPiece.Piece() == PIECE_NONE)
+				continue;
+
+			AddPiece(boardPiece.Colour(), boardPiece.Piece(), SquareFromBoardPosition(x, y));
+		}
+	}
+
+	//The Board keeps en'passant after every double step, but the key only has it when one of our
+	//pawns can actually take.
+	if(board.enPassantSquare != kNoSquare && (PawnAttacks(OppositeColour(sideToMove), board.enPassantSquare) & pieces[sideToMove][PIECE_PAWN]))
+		enPassantSquare = board.enPassantSquare;
+
+	//Only rights whose king and rook are still at home count, whatever the Board says.
+	auto atHome = [this](int square, PIECE piece, COLOUR colour)
+	{
+		return PieceOn(square) == piece && ColourOn(square) == colour;
+	};
+
+	castlingRights = board.castlingRights;
+	if(!atHome(kSquareE1, PIECE_KING, COLOUR_WHITE) || !atHome(kSquareH1, PIECE_ROOK, COLOUR_WHITE))
+		castlingRights &= ~CASTLE_WHITE_KINGSIDE;
+	if(!atHome(kSquareE1, PIECE_KING, COLOUR_WHITE) || !atHome(kSquareA1, PIECE_ROOK, COLOUR_WHITE))
+		castlingRights &= ~CASTLE_WHITE_QUEENSIDE;
+	if(!atHome(kSquareE8, PIECE_KING, COLOUR_BLACK) || !atHome(kSquareH8, PIECE_ROOK, COLOUR_BLACK))
+		castlingRights &= ~CASTLE_BLACK_KINGSIDE;
+	if(!atHome(kSquareE8, PIECE_KING, COLOUR_BLACK) || !atHome(kSquareA8, PIECE_ROOK, COLOUR_BLACK))
+		castlingRights &= ~CASTLE_BLACK_QUEENSIDE;
+
+	key = ComputeKey();
+}
+
+//--------------------------------------------------------------------------------------------------
+
+bool Position::LoadFen(const string& fen)
+{
+	if(ParseFen(fen))
+		return true;
+
+	*this = Position();
+	return false;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+bool Position::ParseFen(const string& fen)
+{
+	*this = Position();
+
+	istringstream fields(fen);
+	string		  placement, side, castling, enPassant;
+	if(!(fields >> placement >> side))
+		return false;
+
+	//Castling, en'passant and the counters are optional, so bare "<placement> <side>" strings load too.
+	if(!(fields >> castling))
+		castling = "-";
+	if(!(fields >> enPassant))
+		enPassant = "-";
+	string halfmove = "0";
+	string fullmove = "1";
+	fields >> halfmove >> fullmove;
+	if(!(istringstream(halfmove) >> halfmoveClock) || !(istringstream(fullmove) >> fullmoveNumber) || halfmoveClock < 0)
+		return false;
+
+	//Some writers start counting moves from 0.
+	fullmoveNumber = max(fullmoveNumber, 1);
+
+	//Placement runs from rank 8 down to rank 1, a to h along each.
+	int rank = 7;
+	int file = 0;
+	for(char symbol : placement)
+	{
+		if(symbol == '/')
+		{
+			if(file != 8 || rank == 0)
+				return false;
+
+			rank--;
+			file = 0;
+		}
+		else if(symbol >= '1' && symbol <= '8')
+		{
+			file += symbol - '0';
+			if(file > 8)
+				return false;
+		}
+		else
+		{
+			const string pieceLetters = "pnbrqk";
+			size_t		 piece		  = pieceLetters.find((char)tolower(symbol));
+			if(piece == string::npos || file > 7)
+				return false;
+
+			AddPiece(isupper(symbol) ? COLOUR_WHITE : COLOUR_BLACK, (PIECE)piece, rank * 8 + file);
+			file++;
+		}
+	}
+
+	if(rank != 0 || file != 8 || CountBits(pieces[COLOUR_WHITE][PIECE_KING]) != 1 || CountBits(pieces[COLOUR_BLACK][PIECE_KING]) != 1)
+		return false;
+
+	if(side == "w")
+		sideToMove = COLOUR_WHITE;
+	else if(side == "b")
+		sideToMove = COLOUR_BLACK;
+	else
+		return false;
+
+	//Rights whose king or rook is not on its start square are dropped, as MakeMove relies on them being there.
+	for(char symbol : castling)
+	{
+		switch(symbol)
+		{
+			case 'K': castlingRights |= CASTLE_WHITE_KINGSIDE;	break;
+			case 'Q': castlingRights |= CASTLE_WHITE_QUEENSIDE; break;
+			case 'k': castlingRights |= CASTLE_BLACK_KINGSIDE;	break;
+			case 'q': castlingRights |= CASTLE_BLACK_QUEENSIDE; break;
+			case '-':											break;
+			default:  return false;
+		}
+	}
+
+	if(PieceOn(kSquareE1) != PIECE_KING || ColourOn(kSquareE1) != COLOUR_WHITE)
+		castlingRights &= ~(CASTLE_WHITE_KINGSIDE | CASTLE_WHITE_QUEENSIDE);
+	if(PieceOn(kSquareE8) != PIECE_KING || ColourOn(kSquareE8) != COLOUR_BLACK)
+		castlingRights &= ~(CASTLE_BLACK_KINGSIDE | CASTLE_BLACK_QUEENSIDE);
+	if(PieceOn(kSquareH1) != PIECE_ROOK || ColourOn(kSquareH1) != COLOUR_WHITE)
+		castlingRights &= ~CASTLE_WHITE_KINGSIDE;
+	if(PieceOn(kSquareA1) != PIECE_ROOK || ColourOn(kSquareA1) != COLOUR_WHITE)
+		castlingRights &= ~CASTLE_WHITE_QUEENSIDE;
+	if(PieceOn(kSquareH8) != PIECE_ROOK || ColourOn(kSquareH8) != COLOUR_BLACK)
+		castlingRights &= ~CASTLE_BLACK_KINGSIDE;
+	if(PieceOn(kSquareA8) != PIECE_ROOK || ColourOn(kSquareA8) != COLOUR_BLACK)
+		castlingRights &= ~CASTLE_BLACK_QUEENSIDE;
+
+	//As with a Board, the en'passant square is only kept when a pawn can actually take onto it.
+	if(enPassant != "-")
+	{
+		if(enPassant.size() != 2 || enPassant[0] < 'a' || enPassant[0] > 'h' || (enPassant[1] != '3' && enPassant[1] != '6'))
+			return false;
+
+		int square = (enPassant[1] - '1') * 8 + (enPassant[0] - 'a');
+		if(PawnAttacks(OppositeColour(sideToMove), square) & pieces[sideToMove][PIECE_PAWN])
+			enPassantSquare = square;
+	}
+
+	key = ComputeKey();
+	return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+string Position::ToFen() const
+{
+	const string pieceLetters = "pnbrqk";
+
+	string fen;
+	for(int rank = 7; rank >= 0; rank--)
+	{
+		int emptySquares = 0;
+		for(int file = 0; file < 8; file++)
+		{
+			int	  square = rank * 8 + file;
+			PIECE piece	 = PieceOn(square);
+			if(piece == PIECE_NONE)
+			{
+				emptySquares++;
+				continue;
+			}
+
+			if(emptySquares > 0)
+				fen += (char)('0' + emptySquares);
+			emptySquares = 0;
+
+			char letter = pieceLetters[piece];
+			fen += ColourOn(square) == COLOUR_WHITE ? (char)toupper(letter) : letter;
+		}
+
+		if(emptySquares > 0)
+			fen += (char)('0' + emptySquares);
+		if(rank > 0)
+			fen += '/';
+	}
+
+	fen += sideToMove == COLOUR_WHITE ? " w " : " b ";
+
+	if(castlingRights == CASTLE_NONE)
+		fen += '-';
+	if(castlingRights & CASTLE_WHITE_KINGSIDE)
+		fen += 'K';
+	if(castlingRights & CASTLE_WHITE_QUEENSIDE)
+		fen += 'Q';
+	if(castlingRights & CASTLE_BLACK_KINGSIDE)
+		fen += 'k';
+	if(castlingRights & CASTLE_BLACK_QUEENSIDE)
+		fen += 'q';
+
+	if(enPassantSquare == kNoSquare)
+	{
+		fen += " -";
+	}
+	else
+	{
+		fen += ' ';
+		fen += (char)('a' + FileOfSquare(enPassantSquare));
+		fen += (char)('1' + RankOfSquare(enPassantSquare));
+	}
+
+	return fen + " " + to_string(halfmoveClock) + " " + to_string(fullmoveNumber);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void Position::ToBoard(Board* board) const
+{
+	for(int x = 0; x < kBoardDimensions; x++)
+	{
+		for(int y = 0; y < kBoardDimensions; y++)
+			board->currentLayout[x][y] = BoardPiece();
+	}
+
+	for(int colour = 0; colour < 2; colour++)
+	{
+		for(int piece = 0; piece < kNumberOfPieces; piece++)
+		{
+			Bitboard bitboard = pieces[colour][piece];
+			while(bitboard)
+			{
+				int square = PopLowestBit(&bitboard);
+				board->currentLayout[BoardXFromSquare(square)][BoardYFromSquare(square)] = BoardPiece((PIECE)piece, (COLOUR)colour);
+			}
+		}
+	}
+
+	board->sideToMove	   = sideToMove;
+	board->castlingRights  = (uint8_t)castlingRights;
+	board->enPassantSquare = (int8_t)enPassantSquare;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+PIECE Position::PieceOn(int square) const
+{
+	Bitboard squareBitboard = SquareBitboard(square);
+	if((occupancy[COLOUR_NONE] & squareBitboard) == 0)
+		return PIECE_NONE;
+
+	COLOUR colour = (occupancy[COLOUR_WHITE] & squareBitboard) ? COLOUR_WHITE : COLOUR_BLACK;
+	for(int piece = 0; piece < kNumberOfPieces; piece++)
+	{
+		if(pieces[colour][piece] & squareBitboard)
+			return (PIECE)piece;
+	}
+
+	return PIECE_NONE;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+uint64_t Position::ComputeKey() const
+{
+	uint64_t computedKey = 0;
+
+	for(int colour = 0; colour < 2; colour++)
+	{
+		for(int piece = 0; piece < kNumberOfPieces; piece++)
+		{
+			Bitboard bitboard = pieces[colour][piece];
+			while(bitboard)
+				computedKey ^= kZobristKeys.pieces[colour][piece][PopLowestBit(&bitboard)];
+		}
+	}
+
+	computedKey ^= kZobristKeys.castling[castlingRights];
+
+	if(enPassantSquare != kNoSquare)
+		computedKey ^= kZobristKeys.enPassantFile[FileOfSquare(enPassantSquare)];
+
+	if(sideToMove == COLOUR_BLACK)
+		computedKey ^= kZobristKeys.blackToMove;
+
+	return computedKey;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+EvalAccumulator Position::ComputeEval() const
+{
+	EvalAccumulator total = EvalAccumulator();
+
+	for(int colour = 0; colour < 2; colour++)
+	{
+		for(int piece = 0; piece < kNumberOfPieces; piece++)
+		{
+			Bitboard pieceBitboard = pieces[colour][piece];
+			while(pieceBitboard)
+			{
+				int square = PopLowestBit(&pieceBitboard);
+				total.middlegame[colour] += kPieceSquareTables.middlegame[colour][piece][square];
+				total.endgame[colour]	 += kPieceSquareTables.endgame[colour][piece][square];
+				total.phase				 += kPhaseWeights[piece];
+			}
+		}
+	}
+
+	return total;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+COLOUR Position::ColourOn(int square) const
+{
+	Bitboard squareBitboard = SquareBitboard(square);
+	if(occupancy[COLOUR_WHITE] & squareBitboard)
+		return COLOUR_WHITE;
+	if(occupancy[COLOUR_BLACK] & squareBitboard)
+		return COLOUR_BLACK;
+
+	return COLOUR_NONE;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void Position::MakeMove(const Move& move)
+{
+	int	   fromSquare = MoveFromSquare(move);
+	int	   toSquare	  = MoveToSquare(move);
+	COLOUR us		  = sideToMove;
+	COLOUR them		  = OppositeColour(us);
+	PIECE  moving	  = PieceOn(fromSquare);
+
+	UndoState undo;
+	undo.move			 = move;
+	undo.captured		 = PieceOn(toSquare);
+	undo.capturedSquare	 = toSquare;
+	undo.promoted		 = PIECE_NONE;
+	undo.castlingRights	 = castlingRights;
+	undo.enPassantSquare = enPassantSquare;
+	undo.halfmoveClock	 = halfmoveClock;
+	undo.key			 = key;
+
+	//Captures and pawn moves can't be undone, so they start the fifty move count again.
+	halfmoveClock = (undo.captured != PIECE_NONE || moving == PIECE_PAWN) ? 0 : halfmoveClock + 1;
+	if(us == COLOUR_BLACK)
+		fullmoveNumber++;
+
+	//Take the old rights and en'passant file out of the key. The piece updates below keep their own part current.
+	key ^= kZobristKeys.castling[castlingRights];
+	if(enPassantSquare != kNoSquare)
+		key ^= kZobristKeys.enPassantFile[FileOfSquare(enPassantSquare)];
+
+	enPassantSquare = kNoSquare;
+
+	if(undo.captured != PIECE_NONE)
+		RemovePiece(them, undo.captured, toSquare);
+
+	MovePiece(us, moving, fromSquare, toSquare);
+
+	if(moving == PIECE_PAWN)
+	{
+		//En'Passant removal of enemy pawn, which sits behind the square we moved to.
+		if(toSquare == undo.enPassantSquare)
+		{
+			undo.captured		= PIECE_PAWN;
+			undo.capturedSquare = toSquare + (us == COLOUR_WHITE ? -8 : 8);
+			RemovePiece(them, PIECE_PAWN, undo.capturedSquare);
+		}
+
+		//Double step - En'passant is available on the square we skipped, if an enemy pawn can reach it.
+		if(toSquare - fromSquare == 16 || fromSquare - toSquare == 16)
+		{
+			int skippedSquare = (fromSquare + toSquare) / 2;
+			if(PawnAttacks(us, skippedSquare) & pieces[them][PIECE_PAWN])
+				enPassantSquare = skippedSquare;
+		}
+
+		//Promotion - Queen unless the move says otherwise.
+		if(RankOfSquare(toSquare) == 0 || RankOfSquare(toSquare) == 7)
+		{
+			undo.promoted = move.Promotion() != PIECE_NONE ? move.Promotion() : PIECE_QUEEN;
+			RemovePiece(us, PIECE_PAWN, toSquare);
+			AddPiece(us, undo.promoted, toSquare);
+		}
+	}
+	else if(moving == PIECE_KING)
+	{
+		//CASTLING - Move the rook.
+		if(toSquare - fromSquare == 2)
+			MovePiece(us, PIECE_ROOK, fromSquare + 3, fromSquare + 1);
+		else if(fromSquare - toSquare == 2)
+			MovePiece(us, PIECE_ROOK, fromSquare - 4, fromSquare - 1);
+	}
+
+	castlingRights &= CastlingRightsMask(fromSquare) & CastlingRightsMask(toSquare);
+	sideToMove = them;
+
+	key ^= kZobristKeys.castling[castlingRights];
+	if(enPassantSquare != kNoSquare)
+		key ^= kZobristKeys.enPassantFile[FileOfSquare(enPassantSquare)];
+	key ^= kZobristKeys.blackToMove;
+
+	undoStack.push_back(undo);
+	hasAttackMap = false;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void Position::UnMakeMove()
+{
+	const UndoState& undo = undoStack.back();
+
+	int	   fromSquare = MoveFromSquare(undo.move);
+	int	   toSquare	  = MoveToSquare(undo.move);
+	COLOUR us		  = OppositeColour(sideToMove);
+
+	//A promoted piece goes back to being a pawn before it steps back.
+	if(undo.promoted != PIECE_NONE)
+	{
+		RemovePiece(us, undo.promoted, toSquare);
+		AddPiece(us, PIECE_PAWN, toSquare);
+	}
+
+	PIECE moving = PieceOn(toSquare);
+	MovePiece(us, moving, toSquare, fromSquare);
+
+	//CASTLING - Put the rook back in the corner.
+	if(moving == PIECE_KING)
+	{
+		if(toSquare - fromSquare == 2)
+			MovePiece(us, PIECE_ROOK, fromSquare + 1, fromSquare + 3);
+		else if(fromSquare - toSquare == 2)
+			MovePiece(us, PIECE_ROOK, fromSquare - 1, fromSquare - 4);
+	}
+
+	if(undo.captured != PIECE_NONE)
+		AddPiece(sideToMove, undo.captured, undo.capturedSquare);
+
+	castlingRights	= undo.castlingRights;
+	enPassantSquare = undo.enPassantSquare;
+	halfmoveClock	= undo.halfmoveClock;
+	key				= undo.key;
+	sideToMove		= us;
+
+	if(us == COLOUR_BLACK)
+		fullmoveNumber--;
+
+	undoStack.pop_back();
+	hasAttackMap = false;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void Position::MakeNullMove()
+{
+	UndoState undo;
+	undo.move			 = Move();
+	undo.captured		 = PIECE_NONE;
+	undo.capturedSquare	 = kNoSquare;
+	undo.promoted		 = PIECE_NONE;
+	undo.castlingRights	 = castlingRights;
+	undo.enPassantSquare = enPassantSquare;
+	undo.halfmoveClock	 = halfmoveClock;
+	undo.key			 = key;
+
+	//Nothing moves, so only the en'passant chance and the side to move change.
+	if(enPassantSquare != kNoSquare)
+		key ^= kZobristKeys.enPassantFile[FileOfSquare(enPassantSquare)];
+	enPassantSquare = kNoSquare;
+
+	sideToMove = OppositeColour(sideToMove);
+	key		  ^= kZobristKeys.blackToMove;
+
+	undoStack.push_back(undo);
+	hasAttackMap = false;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void Position::UnMakeNullMove()
+{
+	const UndoState& undo = undoStack.back();
+
+	enPassantSquare = undo.enPassantSquare;
+	halfmoveClock	= undo.halfmoveClock;
+	key				= undo.key;
+	sideToMove		= OppositeColour(sideToMove);
+
+	undoStack.pop_back();
+	hasAttackMap = false;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void Position::AddPiece(COLOUR colour, PIECE piece, int square)
+{
+	Bitboard squareBitboard = SquareBitboard(square);
+	pieces[colour][piece]  |= squareBitboard;
+	occupancy[colour]	   |= squareBitboard;
+	occupancy[COLOUR_NONE] |= squareBitboard;
+	key					   ^= kZobristKeys.pieces[colour][piece][square];
+
+	eval.middlegame[colour] += kPieceSquareTables.middlegame[colour][piece][square];
+	eval.endgame[colour]	+= kPieceSquareTables.endgame[colour][piece][square];
+	eval.phase				+= kPhaseWeights[piece];
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void Position::RemovePiece(COLOUR colour, PIECE piece, int square)
+{
+	Bitboard squareBitboard = SquareBitboard(square);
+	pieces[colour][piece]  &= ~squareBitboard;
+	occupancy[colour]	   &= ~squareBitboard;
+	occupancy[COLOUR_NONE] &= ~squareBitboard;
+	key					   ^= kZobristKeys.pieces[colour][piece][square];
+
+	eval.middlegame[colour] -= kPieceSquareTables.middlegame[colour][piece][square];
+	eval.endgame[colour]	-= kPieceSquareTables.endgame[colour][piece][square];
+	eval.phase				-= kPhaseWeights[piece];
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void Position::MovePiece(COLOUR colour, PIECE piece, int fromSquare, int toSquare)
+{
+	Bitboard moveBitboard	= SquareBitboard(fromSquare) | SquareBitboard(toSquare);
+	pieces[colour][piece]  ^= moveBitboard;
+	occupancy[colour]	   ^= moveBitboard;
+	occupancy[COLOUR_NONE] ^= moveBitboard;
+	key					   ^= kZobristKeys.pieces[colour][piece][fromSquare] ^ kZobristKeys.pieces[colour][piece][toSquare];
+
+	eval.middlegame[colour] += kPieceSquareTables.middlegame[colour][piece][toSquare] - kPieceSquareTables.middlegame[colour][piece][fromSquare];
+	eval.endgame[colour]	+= kPieceSquareTables.endgame[colour][piece][toSquare] - kPieceSquareTables.endgame[colour][piece][fromSquare];
+}
+
+//--------------------------------------------------------------------------------------------------
+
+string MoveToString(const Move& move)
+{
+	const char promotionLetters[kNumberOfPieces] = { 'p', 'n', 'b', 'r', 'q', 'k' };
+
+	int fromSquare = MoveFromSquare(move);
+	int toSquare   = MoveToSquare(move);
+
+	string text;
+	text += (char)('a' + FileOfSquare(fromSquare));
+	text += (char)('1' + RankOfSquare(fromSquare));
+	text += (char)('a' + FileOfSquare(toSquare));
+	text += (char)('1' + RankOfSquare(toSquare));
+
+	if(move.Promotion() != PIECE_NONE)
+		text += promotionLetters[move.Promotion()];
+
+	return text;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+string BoardToFen(const Board& board)
+{
+	return Position(board).ToFen();
+}
+
+//--------------------------------------------------------------------------------------------------
+
+bool BoardFromFen(const string& fen, Board* board)
+{
+	Position position;
+	if(!position.LoadFen(fen))
+		return false;
+
+	position.ToBoard(board);
+	return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void ApplyMove(Board* board, const Move& move)
+{
+	int fromX = move.FromX();
+	int fromY = move.FromY();
+	int toX	  = move.ToX();
+	int toY	  = move.ToY();
+
+	PIECE moving = board->currentLayout[fromX][fromY].Piece();
+	int	  passed = board->enPassantSquare;
+
+	//Moving a king or rook, or taking a rook at home, loses the matching castling rights.
+	board->castlingRights &= CastlingRightsMask(move.FromSquare()) & CastlingRightsMask(move.ToSquare());
+	board->enPassantSquare = kNoSquare;
+
+	if(moving == PIECE_PAWN)
+	{
+		//If the pawn is on its start position and it double jumps, then en'passant may be available for opponent.
+		if(abs(toY - fromY) == 2)
+			board->enPassantSquare = (int8_t)((move.FromSquare() + move.ToSquare()) / 2);
+
+		//Taking en'passant removes the pawn that double stepped, which sits beside us.
+		if(move.ToSquare() == passed)
+			board->currentLayout[toX][fromY] = BoardPiece();
+	}
+
+	//CASTLING - A king moving 2 spaces takes the rook on that side with it.
+	if(moving == PIECE_KING && abs(toX - fromX) == 2)
+	{
+		int rookFromX = toX > fromX ? kBoardDimensions - 1 : 0;
+		int rookToX	  = (fromX + toX) / 2;
+
+		board->currentLayout[rookToX][fromY]   = board->currentLayout[rookFromX][fromY];
+		board->currentLayout[rookFromX][fromY] = BoardPiece();
+	}
+
+	//Move the piece into new position.
+	board->currentLayout[toX][toY]	   = board->currentLayout[fromX][fromY];
+	board->currentLayout[fromX][fromY] = BoardPiece();
+
+	if(move.Promotion() != PIECE_NONE)
+		board->currentLayout[toX][toY].SetPiece(move.Promotion());
+
+	board->sideToMove = OppositeColour(board->sideToMove);
+}
+
+//--------------------------------------------------------------------------------------------------
@@ -0,0 +1,124 @@
+//------------------------------------------------------------------------
+//  Bitboard-backed position used by move generation, search and scoring.
+//------------------------------------------------------------------------
+
+#ifndef _CHESS_POSITION_H
+#define _CHESS_POSITION_H
+
+#include "ChessCommons.h"
+#include "ChessBitboard.h"
+#include "ChessEvaluation.h"
+#include <string>
+#include <vector>
+using namespace std;
+
+//--------------------------------------------------------------------------------------------------
+
+//Everything MakeMove destroys, so UnMakeMove can put it back.
+struct UndoState
+{
+	Move	move;
+	PIECE	captured;				//PIECE_NONE if nothing was taken.
+	int		capturedSquare;			//Differs from the move's destination for en'passant.
+	PIECE	promoted;				//PIECE_NONE unless a pawn was promoted.
+	int		castlingRights;
+	int		enPassantSquare;
+	int		halfmoveClock;
+	uint64_t key;
+};
+
+//--------------------------------------------------------------------------------------------------
+
+//What the side to move's king is up against - Enough to tell whether a move is legal, or whether
+//there is any legal move at all, without trying them. Filled in by GetAttackMap.
+struct AttackMap
+{
+	int		 kingSquare;
+	Bitboard checkers;				//Enemy pieces giving check.
+	Bitboard checkMask;				//Squares a non-king move must land on. Everywhere when not in check.
+	Bitboard pinned;				//Our pieces that would expose the king if they left its line.
+	Bitboard attacked;				//Every square the enemy attacks, seen through our king - Where it can't go.
+};
+
+//--------------------------------------------------------------------------------------------------
+
+struct Position
+{
+	Bitboard pieces[2][kNumberOfPieces];	//[COLOUR][PIECE] - The 12 piece bitboards.
+	Bitboard occupancy[3];					//[COLOUR_WHITE], [COLOUR_BLACK] and [COLOUR_NONE] for both.
+	COLOUR	 sideToMove;
+	int		 castlingRights;				//CASTLING_RIGHTS flags.
+	int		 enPassantSquare;				//Square a pawn can capture onto, or kNoSquare.
+	int		 halfmoveClock;					//Plies since the last capture or pawn move.
+	int		 fullmoveNumber;				//Starts at 1 and goes up after each black move.
+	uint64_t key;							//Zobrist key, kept up to date by every move.
+	EvalAccumulator eval;					//Running scores, kept up to date by every move.
+	vector<UndoState> undoStack;			//One entry per move made, most recent last.
+
+	//Kept until the position changes. Copy it out before making a move if it is still needed.
+	mutable AttackMap attackMap;
+	mutable bool	  hasAttackMap;
+
+	Position();
+	Position(const Board& board);
+
+	//Forsyth-Edwards Notation. Returns false, leaving an empty position, if the string is malformed.
+	//The move counters are optional and default to 0 and 1.
+	bool	 LoadFen(const string& fen);
+
+	//The en'passant square is only written when a pawn can actually take onto it.
+	string	 ToFen() const;
+
+	void	 ToBoard(Board* board) const;
+
+	PIECE	 PieceOn(int square) const;
+	COLOUR	 ColourOn(int square) const;
+	int		 KingSquare(COLOUR colour) const	{ return LowestBit(pieces[colour][PIECE_KING]); }
+
+	//Anything besides the king and pawns - Without it, zugzwang is common.
+	bool	 HasNonPawnMaterial(COLOUR colour) const	{ return (occupancy[colour] & ~(pieces[colour][PIECE_PAWN] | pieces[colour][PIECE_KING])) != 0; }
+
+	//Builds the key from scratch. Only needed when setting up a position.
+	uint64_t ComputeKey() const;
+
+	//Totals the scores from scratch, to check the running ones against.
+	EvalAccumulator ComputeEval() const;
+
+	//Moves are made and unmade in place - The search never copies a position.
+	void	 MakeMove(const Move& move);
+	void	 UnMakeMove();
+
+	//Passes the turn without moving, for null move pruning. Never legal in a game, and never made
+	//while in check.
+	void	 MakeNullMove();
+	void	 UnMakeNullMove();
+
+private:
+	bool	 ParseFen(const string& fen);
+
+	void	 AddPiece(COLOUR colour, PIECE piece, int square);
+	void	 RemovePiece(COLOUR colour, PIECE piece, int square);
+	void	 MovePiece(COLOUR colour, PIECE piece, int fromSquare, int toSquare);
+};
+
+//--------------------------------------------------------------------------------------------------
+
+inline int MoveFromSquare(const Move& move)	{ return move.FromSquare(); }
+inline int MoveToSquare(const Move& move)	{ return move.ToSquare(); }
+
+//Coordinate notation, e.g. "e2e4" or "e7e8q".
+string MoveToString(const Move& move);
+
+//FEN for the game's Board, by way of a Position. A Board keeps no move counters, so they are
+//written as 0 1 and ignored when read.
+string BoardToFen(const Board& board);
+bool   BoardFromFen(const string& fen, Board* board);
+
+//Plays a move on the game's Board, moving the rook when castling and removing the pawn taken
+//en'passant, then passes the turn. A pawn reaching the back rank only changes piece if the move
+//names a promotion.
+void ApplyMove(Board* board, const Move& move);
+
+//--------------------------------------------------------------------------------------------------
+
+#endif //_CHESS_POSITION_H
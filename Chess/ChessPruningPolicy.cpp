@@ -0,0 +1,159 @@
+//------------------------------------------------------------------------
+//  Forward pruning - Decides which moves the search may skip or search
+//  shallower, and counts what it throws away.
+//------------------------------------------------------------------------
+
+#include "ChessPruningPolicy.h"
+#include <algorithm>
+#include <cmath>
+
+//--------------------------------------------------------------------------------------------------
+
+const int kFutilityMaxDepth	   = 3;
+const int kFutilityMargin[kFutilityMaxDepth + 1] = { 0, 150, 300, 450 };	//Most a quiet move is thought to gain, by depth left.
+
+const int kLateMovePruningMaxDepth = 3;	//Shallower than this, quiet moves past 3 + depth * depth are skipped.
+
+const int kReductionMinDepth   = 3;		//Late moves are searched to full depth any shallower than this,
+const int kFullDepthMoves	   = 3;		//and so are this many moves at every node.
+const int kMaxReducedMoveIndex = 63;
+
+//--------------------------------------------------------------------------------------------------
+
+//Late move reductions, indexed [depth][move number] - Grows with both, as a move deep in a long list
+//at a deep node is the least likely to matter.
+struct LateMoveReductions
+{
+	int reductions[kMaxSearchPly][kMaxReducedMoveIndex + 1];
+
+	LateMoveReductions()
+	{
+		for (int depth = 0; depth < kMaxSearchPly; depth++)
+		{
+			for (int moveIndex = 0; moveIndex <= kMaxReducedMoveIndex; moveIndex++)
+			{
+				reductions[depth][moveIndex] = depth == 0 || moveIndex == 0 ? 0 : (int)(0.75 + log(depth) * log(moveIndex) / 2.25);
+			}
+		}
+	}
+
+	const int* operator[](int depth) const	{ return reductions[depth]; }
+};
+
+const LateMoveReductions kLateMoveReductions;
+
+//--------------------------------------------------------------------------------------------------
+
+void PruningStats::Add(const PruningStats& other)
+{
+	beamPruned		  += other.beamPruned;
+	futilityPruned	  += other.futilityPruned;
+	lateMovesPruned	  += other.lateMovesPruned;
+	reducedMoves	  += other.reducedMoves;
+	reducedResearches += other.reducedResearches;
+	nullMoveCutoffs	  += other.nullMoveCutoffs;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+PruningPolicy::PruningPolicy(PRUNING_MODE mode, int beamWidth)
+{
+	mMode	   = mode;
+	mBeamWidth = max(beamWidth, 1);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+bool PruningPolicy::PruneMove(int depth, int moveNumber, bool isPVNode, bool inCheck, bool isQuiet, bool givesCheck,
+							  int staticScore, int alpha, PruningStats* stats) const
+{
+	if (moveNumber <= 1 || inCheck)
+	{
+		return false;
+	}
+
+	switch (mMode)
+	{
+		case PRUNING_OFF:
+			return false;
+
+		case PRUNING_BEAM:
+			if (moveNumber > mBeamWidth)
+			{
+				stats->beamPruned++;
+				return true;
+			}
+			return false;
+
+		case PRUNING_FUTILITY:
+			//Only quiet moves near the leaves, and never while a mate against us is all that has been
+			//found - Skipping the way out would turn it into a real one.
+			if (isPVNode || !isQuiet || givesCheck || alpha < -kMateThreshold)
+			{
+				return false;
+			}
+
+			if (depth <= kFutilityMaxDepth && staticScore + kFutilityMargin[depth] <= alpha)
+			{
+				stats->futilityPruned++;
+				return true;
+			}
+
+			if (depth <= kLateMovePruningMaxDepth && moveNumber > 3 + depth * depth)
+			{
+				stats->lateMovesPruned++;
+				return true;
+			}
+			return false;
+	}
+	return false;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+int PruningPolicy::Reduction(int depth, int moveNumber, bool isPVNode, bool inCheck, bool isQuiet, bool givesCheck) const
+{
+	if (mMode != PRUNING_FUTILITY || !isQuiet || inCheck || givesCheck || depth < kReductionMinDepth || moveNumber <= kFullDepthMoves)
+	{
+		return 0;
+	}
+
+	int reduction = kLateMoveReductions[min(depth, kMaxSearchPly - 1)][min(moveNumber, kMaxReducedMoveIndex)];
+	if (isPVNode)
+	{
+		reduction--;
+	}
+
+	//Always leave at least a ply of real search.
+	return clamp(reduction, 0, depth - 2);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+string PruningPolicy::ModeToString(PRUNING_MODE mode)
+{
+	switch (mode)
+	{
+		case PRUNING_OFF:	   return "Off";
+		case PRUNING_BEAM:	   return "Beam";
+		case PRUNING_FUTILITY: return "Futility";
+	}
+	return "";
+}
+
+//--------------------------------------------------------------------------------------------------
+
+bool PruningPolicy::ModeFromString(const string& text, PRUNING_MODE* mode)
+{
+	for (PRUNING_MODE candidate : { PRUNING_OFF, PRUNING_BEAM, PRUNING_FUTILITY })
+	{
+		if (ModeToString(candidate) == text)
+		{
+			*mode = candidate;
+			return true;
+		}
+	}
+	return false;
+}
+
+//--------------------------------------------------------------------------------------------------
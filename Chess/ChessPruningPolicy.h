@@ -0,0 +1,71 @@
+//------------------------------------------------------------------------
+//  Forward pruning - Decides which moves the search may skip or search
+//  shallower, and counts what it throws away.
+//------------------------------------------------------------------------
+
+#ifndef _CHESS_PRUNINGPOLICY_H
+#define _CHESS_PRUNINGPOLICY_H
+
+#include "ChessConstants.h"
+#include <cstdint>
+#include <string>
+using namespace std;
+
+//--------------------------------------------------------------------------------------------------
+
+enum PRUNING_MODE
+{
+	PRUNING_OFF,			//Full width - Every legal move is searched to full depth. The reference for the others.
+	PRUNING_BEAM,			//Only the first few moves at each node, however good the rest might be.
+	PRUNING_FUTILITY		//Null move, futility and late move pruning, and late move reductions.
+};
+
+//--------------------------------------------------------------------------------------------------
+
+//What a search pruned. Each thread keeps its own, and the manager adds them up.
+struct PruningStats
+{
+	uint64_t beamPruned		  = 0;	//Moves past the beam width.
+	uint64_t futilityPruned	  = 0;	//Quiet moves that could not raise the score to alpha.
+	uint64_t lateMovesPruned  = 0;	//Quiet moves too far down the list at shallow depth.
+	uint64_t reducedMoves	  = 0;	//Moves searched shallower than the rest.
+	uint64_t reducedResearches = 0;	//Reduced moves that beat alpha, and had to be searched again in full.
+	uint64_t nullMoveCutoffs  = 0;	//Nodes cut off without searching a single move.
+
+	uint64_t TotalPruned() const	{ return beamPruned + futilityPruned + lateMovesPruned; }
+	void	 Add(const PruningStats& other);
+};
+
+//--------------------------------------------------------------------------------------------------
+
+class PruningPolicy
+{
+//--------------------------------------------------------------------------------------------------
+public:
+	PruningPolicy(PRUNING_MODE mode = PRUNING_FUTILITY, int beamWidth = kMaxMovesPerPly);
+
+	PRUNING_MODE GetMode() const							{ return mMode; }
+	int			 GetBeamWidth() const						{ return mBeamWidth; }
+
+	bool		 AllowNullMove() const						{ return mMode == PRUNING_FUTILITY; }
+
+	//Whether the moveNumber'th legal move at the node can be skipped without searching it. The
+	//first move is always searched, and nothing is skipped while in check. Counts the reason in stats.
+	bool		 PruneMove(int depth, int moveNumber, bool isPVNode, bool inCheck, bool isQuiet, bool givesCheck,
+						   int staticScore, int alpha, PruningStats* stats) const;
+
+	//Plies to take off the search of a move that was not pruned.
+	int			 Reduction(int depth, int moveNumber, bool isPVNode, bool inCheck, bool isQuiet, bool givesCheck) const;
+
+	static string ModeToString(PRUNING_MODE mode);
+	static bool	  ModeFromString(const string& text, PRUNING_MODE* mode);
+
+//--------------------------------------------------------------------------------------------------
+private:
+	PRUNING_MODE mMode;
+	int			 mBeamWidth;
+};
+
+//--------------------------------------------------------------------------------------------------
+
+#endif //_CHESS_PRUNINGPOLICY_H
@@ -0,0 +1,928 @@
+//------------------------------------------------------------------------
+//  Lazy SMP search - Every thread runs the same iterative deepening over
+//  one shared transposition table.
+//------------------------------------------------------------------------
+
+#include "ChessSearch.h"
+#include <algorithm>
+#include <cassert>
+#include <climits>
+#include <cstring>
+#include <thread>
+#include "ChessMoveGenerator.h"
+
+using namespace::std;
+
+//--------------------------------------------------------------------------------------------------
+
+const int kPVMoveScore	 = INT_MAX;		//Last iteration's principal variation is searched first,
+const int kHashMoveScore = INT_MAX - 1;	//then the transposition table's best move.
+const unsigned int kTimeCheckNodes = 2048;	//Nodes searched between looks at the clock.
+const int kDeltaMargin = 200;	//Positional swing a capture might bring on top of the piece taken.
+const int kMaxHistoryScore = 1 << 16;	//History is halved once any entry passes this, so old cutoffs fade.
+
+const int kNullMoveMinDepth	   = 3;	//Shallower than this the reduced search would be straight into quiescence.
+const int kNullMoveReduction   = 2;	//Plies the null move search is cut by, plus one more every four plies of depth.
+const int kNullMoveVerifyPhase = 6;	//At or below this much material a null move cutoff is checked with a real search.
+
+//Tablebase wins score below any mate, so a mate the search can see is still preferred.
+const int kTablebaseWinScore	   = kMateThreshold - kMaxSearchPly;
+const int kTablebaseDepthBonus	   = 6;	//A tablebase result is worth more than a search this much deeper.
+
+//--------------------------------------------------------------------------------------------------
+
+SearchWorker::SearchWorker(SearchManager* manager, int threadIndex)
+{
+	mManager			= manager;
+	mTranspositionTable = manager->GetTranspositionTable();
+	mTablebases			= manager->GetTablebases();
+	mThreadIndex		= threadIndex;
+	mTeamColour			= COLOUR_WHITE;
+	mOpponentColour		= COLOUR_BLACK;
+	mNodesSearched		= 0;
+	mSearchAborted		= false;
+	mFollowingPV		= false;
+	mBestScore			= 0;
+	mCompletedDepth		= 0;
+
+	ClearKillers();
+	ClearHistory();
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void SearchWorker::Search(const Position& position, const SearchLimits& limits)
+{
+	mSearchPosition = position;
+	mSearchPosition.undoStack.reserve(kMaxGamePly);
+	mLimits			= limits;
+	mPruning		= mManager->GetPruningPolicy();
+	mTeamColour		= position.sideToMove;
+	mOpponentColour = OppositeColour(position.sideToMove);
+
+	//Killers belong to the old tree, but which moves tend to cut off still holds - It just counts
+	//for less.
+	ClearKillers();
+	AgeHistory();
+
+	//Inside the tablebases, only the moves that keep the best result are searched. Which ones they
+	//are is worked out once, rather than every iteration.
+	mTablebaseRootMoves.Clear();
+	if (mTablebases->CanProbe(mSearchPosition))
+	{
+		GenerateMoves(mSearchPosition, &mTablebaseRootMoves);
+		if (!mTablebases->FilterRootMoves(mSearchPosition, &mTablebaseRootMoves))
+		{
+			mTablebaseRootMoves.Clear();
+		}
+	}
+
+	mBestScore = IterativeDeepening(&mBestMove);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+int SearchWorker::IterativeDeepening(Move* bestMove)
+{
+	mNodesSearched	= 0;
+	mPruningStats	= PruningStats();
+	mSearchAborted	= false;
+	mCompletedDepth = 0;
+	mPrincipalVariation.clear();
+
+	//Odd helper threads start a ply deeper so the threads spread out over different depths.
+	int firstDepth = mThreadIndex % 2 == 0 ? 1 : 2;
+	int maxDepth   = min(mLimits.depth, kMaxSearchPly - 1);
+	int bestScore  = 0;
+
+	for (int depth = min(firstDepth, maxDepth); depth <= maxDepth; depth++)
+	{
+		Move iterationBestMove;
+		mFollowingPV = true;
+		int score	 = MiniMax(depth, &iterationBestMove);
+
+		//An unfinished iteration is thrown away, unless there is nothing better to fall back on.
+		if (mSearchAborted)
+		{
+			if (mCompletedDepth == 0)
+			{
+				*bestMove = iterationBestMove;
+				bestScore = score;
+			}
+			break;
+		}
+
+		*bestMove		= iterationBestMove;
+		bestScore		= score;
+		mCompletedDepth = depth;
+		mPrincipalVariation.assign(mPVTable[0], mPVTable[0] + mPVLength[0]);
+
+		//Only the main thread reports and decides when to stop. Helpers run until told to.
+		if (mThreadIndex == 0)
+		{
+			SearchInfo info;
+			info.depth				= depth;
+			info.score				= score;
+			info.nodes				= mManager->GetNodesSearched();
+			info.timeMS				= chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - mManager->GetStartTime()).count();
+			info.principalVariation = mPrincipalVariation;
+			mManager->Report(info);
+
+			//Stop on a forced mate, or when the next iteration has little chance of finishing in time.
+			if (abs(score) > kMateThreshold || (mLimits.timeLimitMS != 0 && info.timeMS * 2 >= mLimits.timeLimitMS))
+			{
+				break;
+			}
+		}
+	}
+	return bestScore;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+int SearchWorker::MiniMax(int depth, Move* bestMove)
+{
+	int alpha = -INT_MAX;
+	int beta  = INT_MAX;
+
+	//A previous search of this position gives the move to try first.
+	TTEntry entry;
+	Move	hashMove;
+	bool	haveHashMove = mTranspositionTable->Probe(mSearchPosition.key, &entry) && entry.HasBestMove();
+	if (haveHashMove)
+	{
+		hashMove = entry.GetBestMove();
+	}
+
+	mPVLength[0] = 0;
+
+	if (mTablebaseRootMoves.Empty())
+	{
+		GenerateMoves(mSearchPosition, &moves);
+	}
+	else
+	{
+		moves = mTablebaseRootMoves;
+	}
+	OrderMoves(mSearchPosition, &moves, true, haveHashMove ? &hashMove : nullptr, GetPrincipalVariationMove(0));
+
+	if (!moves.Empty())
+	{
+		*bestMove = moves[0];
+	}
+
+	bool inCheck   = IsInCheck(mSearchPosition, mSearchPosition.sideToMove);
+	bool firstMove = true;
+	int	 moveNumber = 0;
+	for (Move& move : moves)
+	{
+		moveNumber++;
+		bool isQuiet	= MovePicker::IsQuietMove(mSearchPosition, move);
+		bool givesCheck = GivesCheck(mSearchPosition, move);
+
+		//The root is always a PV node, so only a beam ever trims it. Skipped moves are never made.
+		if (mPruning.PruneMove(depth, moveNumber, true, inCheck, isQuiet, givesCheck, 0, alpha, &mPruningStats))
+		{
+			continue;
+		}
+
+		mSearchPosition.MakeMove(move);
+
+		//Principal variation search - Only the first move gets the full window. The rest just have
+		//to be shown no better, and are searched again properly if they turn out to be.
+		int eval;
+		if (firstMove)
+		{
+			eval = -AlphaBeta(depth - 1, -beta, -alpha, 1);
+		}
+		else
+		{
+			eval = -AlphaBeta(depth - 1, -alpha - 1, -alpha, 1);
+			if (eval > alpha && !mSearchAborted)
+			{
+				eval = -AlphaBeta(depth - 1, -beta, -alpha, 1);
+			}
+		}
+		mSearchPosition.UnMakeMove();
+		firstMove = false;
+
+		if (mSearchAborted)
+		{
+			break;
+		}
+
+		if (eval > alpha)
+		{
+			alpha = eval;
+			*bestMove = move;
+			UpdatePrincipalVariation(move, 0);
+		}
+	}
+
+	//A beam may have skipped root moves, so the best score found is only known to be a lower bound.
+	if (!moves.Empty() && !mSearchAborted)
+	{
+		mTranspositionTable->Store(mSearchPosition.key, depth, TT_BOUND_LOWER, TranspositionTable::ScoreToTable(alpha, 0), bestMove);
+	}
+	return alpha;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+int SearchWorker::AlphaBeta(int depth, int alpha, int beta, int ply, bool allowNullMove)
+{
+	//Settle any captures still going on before trusting the score.
+	if (depth <= 0)
+	{
+		return Quiescence(alpha, beta, ply);
+	}
+
+	mPVLength[ply] = ply;
+
+	if (OutOfTime())
+	{
+		return 0;
+	}
+
+	//Only nodes searched with an open window can change the principal variation. Everything else
+	//is just proving a move no better than one already found.
+	bool isPVNode = beta - alpha > 1;
+
+	//Reuse what is known about this position from elsewhere in the tree.
+	const int originalAlpha = alpha;
+	TTEntry	  entry;
+	Move	  hashMove;
+	bool	  haveHashMove = false;
+	if (mTranspositionTable->Probe(mSearchPosition.key, &entry))
+	{
+		if (entry.depth >= depth)
+		{
+			int score = TranspositionTable::ScoreFromTable(entry.score, ply);
+			if (entry.bound == TT_BOUND_EXACT ||
+				(entry.bound == TT_BOUND_LOWER && score >= beta) ||
+				(entry.bound == TT_BOUND_UPPER && score <= alpha))
+			{
+				return score;
+			}
+		}
+
+		if (entry.HasBestMove())
+		{
+			hashMove	 = entry.GetBestMove();
+			haveHashMove = true;
+		}
+	}
+
+	//Small enough endgames have a known result. Cursed wins and blessed losses count as wins and
+	//losses - Nothing here tracks the fifty move rule.
+	int wdl;
+	if (mTablebases->ProbeWDL(mSearchPosition, &wdl))
+	{
+		int		 score = wdl > 0 ? kTablebaseWinScore : wdl < 0 ? -kTablebaseWinScore : 0;
+		TT_BOUND bound = wdl > 0 ? TT_BOUND_LOWER : wdl < 0 ? TT_BOUND_UPPER : TT_BOUND_EXACT;
+		if (bound == TT_BOUND_EXACT ||
+			(bound == TT_BOUND_LOWER && score >= beta) ||
+			(bound == TT_BOUND_UPPER && score <= alpha))
+		{
+			mTranspositionTable->Store(mSearchPosition.key, min(depth + kTablebaseDepthBonus, kMaxSearchPly - 1), bound, score, nullptr);
+			return score;
+		}
+	}
+
+	AttackMap attackMap;
+	ComputeAttackMap(mSearchPosition, &attackMap);
+	bool inCheck = attackMap.checkers != 0;
+
+	//The board as it stands, for deciding what is worth searching. Meaningless in check.
+	int staticScore = 0;
+	if (!inCheck)
+	{
+		staticScore = ScoreTheBoard(mSearchPosition);
+		if (mSearchPosition.sideToMove != mTeamColour)
+		{
+			staticScore = -staticScore;
+		}
+	}
+
+	//Null move pruning - If passing the turn still leaves us above beta, a real move almost certainly
+	//would too. Passing is no help when in check, and is the best move in too many pawn endings.
+	if (allowNullMove && mPruning.AllowNullMove() && !isPVNode && !inCheck && depth >= kNullMoveMinDepth &&
+		mSearchPosition.HasNonPawnMaterial(mSearchPosition.sideToMove))
+	{
+		if (staticScore >= beta)
+		{
+			int reduction = kNullMoveReduction + depth / 4;
+
+			mSearchPosition.MakeNullMove();
+			int eval = -AlphaBeta(depth - 1 - reduction, -beta, -beta + 1, ply + 1, false);
+			mSearchPosition.UnMakeNullMove();
+
+			if (mSearchAborted)
+			{
+				return 0;
+			}
+
+			if (eval >= beta)
+			{
+				//A mate found after passing proves nothing about the real moves.
+				if (eval > kMateThreshold)
+				{
+					eval = beta;
+				}
+
+				//With little material left the side to move may be in zugzwang, where passing is
+				//better than anything it can actually play. Check with a reduced search of the real moves.
+				if (mSearchPosition.eval.phase > kNullMoveVerifyPhase)
+				{
+					mPruningStats.nullMoveCutoffs++;
+					return eval;
+				}
+
+				int verify = AlphaBeta(depth - 1 - reduction, beta - 1, beta, ply, false);
+				if (mSearchAborted)
+				{
+					return 0;
+				}
+				if (verify >= beta)
+				{
+					mPruningStats.nullMoveCutoffs++;
+					return eval;
+				}
+			}
+		}
+	}
+
+	//Moves are only checked for legality when their turn comes to be searched. Most nodes cut off
+	//long before the last move is reached, and the picker only generates what is asked of it.
+	MovePicker picker(mSearchPosition, mHistory, GetPrincipalVariationMove(ply), haveHashMove ? &hashMove : nullptr, mKillers[ply]);
+
+	int	 max		= -INT_MAX;
+	int	 legalMoves = 0;
+	Move bestMove;
+	Move move;
+	while (picker.NextMove(&move))
+	{
+		if (!IsLegalMove(mSearchPosition, attackMap, move))
+		{
+			continue;
+		}
+		legalMoves++;
+
+		bool isQuiet	= MovePicker::IsQuietMove(mSearchPosition, move);
+		bool givesCheck = GivesCheck(mSearchPosition, move);
+
+		//Decided before the move is made, so a pruned move costs no more than the test.
+		if (mPruning.PruneMove(depth, legalMoves, isPVNode, inCheck, isQuiet, givesCheck, staticScore, alpha, &mPruningStats))
+		{
+			continue;
+		}
+
+		mSearchPosition.MakeMove(move);
+
+		int eval;
+		if (legalMoves == 1)
+		{
+			eval = -AlphaBeta(depth - 1, -beta, -alpha, ply + 1);
+		}
+		else
+		{
+			//Late moves are searched shallower, and only in full if they beat alpha anyway.
+			int reduction = mPruning.Reduction(depth, legalMoves, isPVNode, inCheck, isQuiet, givesCheck);
+			if (reduction > 0)
+			{
+				mPruningStats.reducedMoves++;
+			}
+
+			eval = -AlphaBeta(depth - 1 - reduction, -alpha - 1, -alpha, ply + 1);
+			if (eval > alpha && reduction > 0 && !mSearchAborted)
+			{
+				mPruningStats.reducedResearches++;
+				eval = -AlphaBeta(depth - 1, -alpha - 1, -alpha, ply + 1);
+			}
+			if (eval > alpha && eval < beta && !mSearchAborted)
+			{
+				eval = -AlphaBeta(depth - 1, -beta, -alpha, ply + 1);
+			}
+		}
+
+		mSearchPosition.UnMakeMove();
+
+		if (mSearchAborted)
+		{
+			return 0;
+		}
+
+		if (eval > max)
+		{
+			max		 = eval;
+			bestMove = move;
+			if (eval > alpha)
+			{
+				alpha = eval;
+				UpdatePrincipalVariation(move, ply);
+			}
+		}
+		if (alpha >= beta)
+		{
+			if (isQuiet)
+			{
+				UpdateQuietMoveHistory(move, depth, ply);
+			}
+			break;
+		}
+	}
+
+	//No legal moves - CHECKMATE or STALEMATE.
+	if (legalMoves == 0)
+	{
+		return inCheck ? -kMateScore + ply : 0;
+	}
+
+	TT_BOUND bound = TT_BOUND_EXACT;
+	if (max >= beta)
+	{
+		bound = TT_BOUND_LOWER;
+	}
+	else if (max <= originalAlpha)
+	{
+		bound = TT_BOUND_UPPER;
+	}
+	mTranspositionTable->Store(mSearchPosition.key, depth, bound, TranspositionTable::ScoreToTable(max, ply), &bestMove);
+
+	return max;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+int SearchWorker::Quiescence(int alpha, int beta, int ply)
+{
+	mPVLength[ply] = ply;
+
+	if (OutOfTime())
+	{
+		return 0;
+	}
+
+	//Negamax - Scores are always from the point of view of the side to move.
+	int standPat = ScoreTheBoard(mSearchPosition);
+	if (mSearchPosition.sideToMove != mTeamColour)
+	{
+		standPat = -standPat;
+	}
+
+	if (ply >= kMaxSearchPly - 1)
+	{
+		return standPat;
+	}
+
+	AttackMap attackMap;
+	ComputeAttackMap(mSearchPosition, &attackMap);
+	bool inCheck = attackMap.checkers != 0;
+
+	int max;
+	if (inCheck)
+	{
+		//No standing still when in check - Every way out has to be tried, quiet or not.
+		max = -INT_MAX;
+	}
+	else
+	{
+		//Stand pat - The side to move need not capture at all, so the board as it stands is the least
+		//it can score.
+		if (standPat >= beta)
+		{
+			return standPat;
+		}
+
+		//Delta pruning - Even winning a queen would not bring the score back up to alpha.
+		if (standPat + kEndgamePieceScores[PIECE_QUEEN] + kDeltaMargin < alpha)
+		{
+			return standPat;
+		}
+
+		alpha = std::max(alpha, standPat);
+		max	  = standPat;
+	}
+
+	MovePicker picker(mSearchPosition, mHistory, nullptr, nullptr, nullptr, !inCheck);
+
+	int	 legalMoves = 0;
+	Move move;
+	while (picker.NextMove(&move))
+	{
+		if (!IsLegalMove(mSearchPosition, attackMap, move))
+		{
+			continue;
+		}
+		legalMoves++;
+
+		//The same test for each capture - Skip it if taking the piece for free still falls short.
+		if (!inCheck && move.Promotion() == PIECE_NONE)
+		{
+			PIECE captured = mSearchPosition.PieceOn(MoveToSquare(move));
+			int	  gain	   = kEndgamePieceScores[captured == PIECE_NONE ? PIECE_PAWN : captured];
+			if (standPat + gain + kDeltaMargin <= alpha)
+			{
+				continue;
+			}
+		}
+
+		mSearchPosition.MakeMove(move);
+		int eval = -Quiescence(-beta, -alpha, ply + 1);
+		mSearchPosition.UnMakeMove();
+
+		if (mSearchAborted)
+		{
+			return 0;
+		}
+
+		if (eval > max)
+		{
+			max = eval;
+			if (eval > alpha)
+			{
+				alpha = eval;
+			}
+		}
+		if (alpha >= beta) break;
+	}
+
+	//In check with no way out - CHECKMATE.
+	if (inCheck && legalMoves == 0)
+	{
+		return -kMateScore + ply;
+	}
+
+	return max;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+bool SearchWorker::OutOfTime()
+{
+	uint64_t nodes = mNodesSearched.load(memory_order_relaxed) + 1;
+	mNodesSearched.store(nodes, memory_order_relaxed);
+
+	//Reading the clock is slow, so the main thread only looks every few thousand nodes.
+	if (mThreadIndex == 0 && nodes % kTimeCheckNodes == 0)
+	{
+		long long elapsedMS = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - mManager->GetStartTime()).count();
+		if (mLimits.timeLimitMS != 0 && elapsedMS >= mLimits.timeLimitMS)
+		{
+			mManager->Stop();
+		}
+
+		if (mLimits.nodeLimit != 0 && mManager->GetNodesSearched() >= mLimits.nodeLimit)
+		{
+			mManager->Stop();
+		}
+	}
+
+	if (mManager->IsStopping())
+	{
+		mSearchAborted = true;
+	}
+	return mSearchAborted;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void SearchWorker::UpdatePrincipalVariation(const Move& move, int ply)
+{
+	//This ply's line is the move followed by the line of the child that was just searched.
+	mPVTable[ply][ply] = move;
+	for (int nextPly = ply + 1; nextPly < mPVLength[ply + 1]; nextPly++)
+	{
+		mPVTable[ply][nextPly] = mPVTable[ply + 1][nextPly];
+	}
+	mPVLength[ply] = max(mPVLength[ply + 1], ply + 1);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+const Move* SearchWorker::GetPrincipalVariationMove(int ply)
+{
+	//Only the leftmost path of the tree follows the previous iteration's line. Once the search
+	//steps off it there is nothing more to reuse.
+	if (!mFollowingPV || ply >= (int)mPrincipalVariation.size())
+	{
+		mFollowingPV = false;
+		return nullptr;
+	}
+
+	if (IsPseudoLegalMove(mSearchPosition, mPrincipalVariation[ply]))
+	{
+		return &mPrincipalVariation[ply];
+	}
+
+	mFollowingPV = false;
+	return nullptr;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void SearchWorker::UpdateQuietMoveHistory(const Move& move, int depth, int ply)
+{
+	//Killers - The newest goes first, and the same move never fills both slots.
+	if (!(move == mKillers[ply][0]))
+	{
+		for (int killer = kKillersPerPly - 1; killer > 0; killer--)
+		{
+			mKillers[ply][killer] = mKillers[ply][killer - 1];
+		}
+		mKillers[ply][0] = move;
+	}
+
+	//Cutoffs near the root save far more work, so they count for more.
+	int& history = mHistory[mSearchPosition.sideToMove][MoveFromSquare(move)][MoveToSquare(move)];
+	history		+= depth * depth;
+	if (history > kMaxHistoryScore)
+	{
+		AgeHistory();
+	}
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void SearchWorker::ClearKillers()
+{
+	//From and to the same square - Never a possible move, so never picked.
+	for (int ply = 0; ply < kMaxSearchPly; ply++)
+	{
+		for (int killer = 0; killer < kKillersPerPly; killer++)
+		{
+			mKillers[ply][killer] = Move();
+		}
+	}
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void SearchWorker::ClearHistory()
+{
+	memset(mHistory, 0, sizeof(mHistory));
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void SearchWorker::AgeHistory()
+{
+	for (int colour = 0; colour < 2; colour++)
+	{
+		for (int from = 0; from < 64; from++)
+		{
+			for (int to = 0; to < 64; to++)
+			{
+				mHistory[colour][from][to] /= 2;
+			}
+		}
+	}
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void SearchWorker::OrderMoves(const Position& position, MoveList* moves, bool highToLow, const Move* hashMove, const Move* pvMove)
+{
+	ValueMoves(position, moves);
+	for (int index = 0; index < moves->Size(); index++)
+	{
+		const Move& move = (*moves)[index];
+		if (pvMove != nullptr && move == *pvMove)
+		{
+			moves->Score(index) = highToLow ? kPVMoveScore : -kPVMoveScore;
+		}
+		else if (hashMove != nullptr && move == *hashMove)
+		{
+			moves->Score(index) = highToLow ? kHashMoveScore : -kHashMoveScore;
+		}
+	}
+
+	moves->SortByScore(highToLow);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void SearchWorker::ValueMoves(const Position& position, MoveList* moves)
+{
+	//Each move is scored on its own - Captures by what they take and with what, quiet moves by how
+	//often they have cut off before.
+	for (int index = 0; index < moves->Size(); index++)
+	{
+		const Move& move = (*moves)[index];
+		if (MovePicker::IsQuietMove(position, move))
+		{
+			moves->Score(index) = mHistory[position.sideToMove][MoveFromSquare(move)][MoveToSquare(move)];
+		}
+		else
+		{
+			moves->Score(index) = MovePicker::ScoreCapture(position, move);
+		}
+	}
+}
+
+//--------------------------------------------------------------------------------------------------
+
+int SearchWorker::ScoreTheBoard(const Position& positionToScore)
+{
+	//The position keeps its scores current as moves are made, so scoring a leaf is a few subtractions.
+	//Debug builds make sure the running totals never drift from a full count.
+	assert(positionToScore.eval == positionToScore.ComputeEval());
+
+	return TaperedScore(positionToScore.eval, mTeamColour);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+int ScoreToCentipawns(int score)
+{
+	return score * 100 / kMiddlegamePieceScores[PIECE_PAWN];
+}
+
+//--------------------------------------------------------------------------------------------------
+//--------------------------------------------------------------------------------------------------
+
+SearchManager::SearchManager(size_t hashSizeMB, unsigned int threadCount)
+	: mTranspositionTable(hashSizeMB)
+{
+	mStop = false;
+	SetThreadCount(threadCount);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+SearchManager::~SearchManager()
+{
+	Stop();
+	WaitForSearch();
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void SearchManager::SetHashSize(size_t megabytes)
+{
+	Stop();
+	WaitForSearch();
+
+	mTranspositionTable.Resize(megabytes);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void SearchManager::SetThreadCount(unsigned int threadCount)
+{
+	Stop();
+	WaitForSearch();
+
+	if (threadCount == 0)
+	{
+		threadCount = max(1u, thread::hardware_concurrency());
+	}
+
+	mWorkers.clear();
+	for (unsigned int index = 0; index < threadCount; index++)
+	{
+		mWorkers.push_back(make_unique<SearchWorker>(this, (int)index));
+	}
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void SearchManager::ClearHash()
+{
+	Stop();
+	WaitForSearch();
+
+	mTranspositionTable.Clear();
+	for (unique_ptr<SearchWorker>& worker : mWorkers)
+	{
+		worker->ClearHistory();
+	}
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void SearchManager::SetTablebasePath(const string& paths)
+{
+	Stop();
+	WaitForSearch();
+
+	mTablebases.SetPath(paths);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+int SearchManager::Search(const Position& position, const SearchLimits& limits, Move* bestMove)
+{
+	Stop();
+	WaitForSearch();
+
+	mStop = false;
+	return RunSearch(position, limits, bestMove);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+future<SearchResult> SearchManager::StartSearch(const Position& position, const SearchLimits& limits)
+{
+	Stop();
+	WaitForSearch();
+
+	//Cleared here rather than on the search thread, so a Stop straight after this is not lost.
+	mStop = false;
+
+	promise<SearchResult> result;
+	future<SearchResult>  pendingResult = result.get_future();
+
+	mSearchThread = thread([this, position, limits, result = std::move(result)]() mutable
+	{
+		SearchResult searchResult;
+		searchResult.score = RunSearch(position, limits, &searchResult.bestMove);
+		result.set_value(searchResult);
+	});
+
+	return pendingResult;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void SearchManager::WaitForSearch()
+{
+	if (mSearchThread.joinable())
+	{
+		mSearchThread.join();
+	}
+}
+
+//--------------------------------------------------------------------------------------------------
+
+int SearchManager::RunSearch(const Position& position, const SearchLimits& limits, Move* bestMove)
+{
+	mStartTime = chrono::steady_clock::now();
+	mTranspositionTable.NewSearch();
+
+	//Helpers search on their own threads while this thread runs the main search.
+	vector<thread> helpers;
+	for (size_t index = 1; index < mWorkers.size(); index++)
+	{
+		SearchWorker* worker = mWorkers[index].get();
+		helpers.emplace_back([worker, &position, &limits]() { worker->Search(position, limits); });
+	}
+
+	mWorkers[0]->Search(position, limits);
+
+	Stop();
+	for (thread& helper : helpers)
+	{
+		helper.join();
+	}
+
+	//Take the main thread's move unless a helper got further.
+	SearchWorker* best = mWorkers[0].get();
+	for (unique_ptr<SearchWorker>& worker : mWorkers)
+	{
+		if (worker->GetCompletedDepth() > best->GetCompletedDepth())
+		{
+			best = worker.get();
+		}
+	}
+
+	*bestMove = best->GetBestMove();
+	return best->GetBestScore();
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void SearchManager::Report(const SearchInfo& info)
+{
+	//Silent unless someone is listening - Whoever owns the search decides where its progress goes.
+	if (mReporter)
+	{
+		mReporter(info);
+	}
+}
+
+//--------------------------------------------------------------------------------------------------
+
+PruningStats SearchManager::GetPruningStats() const
+{
+	PruningStats total;
+	for (const unique_ptr<SearchWorker>& worker : mWorkers)
+	{
+		total.Add(worker->GetPruningStats());
+	}
+	return total;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+uint64_t SearchManager::GetNodesSearched() const
+{
+	uint64_t total = 0;
+	for (const unique_ptr<SearchWorker>& worker : mWorkers)
+	{
+		total += worker->GetNodesSearched();
+	}
+	return total;
+}
+
+//--------------------------------------------------------------------------------------------------
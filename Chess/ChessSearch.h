@@ -0,0 +1,199 @@
+//------------------------------------------------------------------------
+//  Lazy SMP search - Every thread runs the same iterative deepening over
+//  one shared transposition table.
+//------------------------------------------------------------------------
+
+#ifndef _CHESS_SEARCH_H
+#define _CHESS_SEARCH_H
+
+#include "ChessCommons.h"
+#include "ChessConstants.h"
+#include "ChessMoveList.h"
+#include "ChessMovePicker.h"
+#include "ChessPosition.h"
+#include "ChessPruningPolicy.h"
+#include "ChessTablebases.h"
+#include "ChessTranspositionTable.h"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+using namespace std;
+
+class SearchManager;
+
+//--------------------------------------------------------------------------------------------------
+
+struct SearchLimits
+{
+	int			 depth		 = kMaxSearchPly - 1;	//Deepest iteration to run.
+	unsigned int timeLimitMS = 0;					//Wall clock budget for the whole search. 0 for none.
+	uint64_t	 nodeLimit	 = 0;					//Nodes across every thread before stopping. 0 for none.
+};
+
+//--------------------------------------------------------------------------------------------------
+
+struct SearchResult
+{
+	Move bestMove;
+	int	 score;
+};
+
+//--------------------------------------------------------------------------------------------------
+
+//Progress after each completed iteration, as handed to the manager's reporter.
+struct SearchInfo
+{
+	int			 depth;
+	int			 score;
+	uint64_t	 nodes;
+	long long	 timeMS;
+	vector<Move> principalVariation;
+};
+
+typedef function<void(const SearchInfo&)> SearchReporter;
+
+//Scores are in the evaluation's own units. This converts to hundredths of a pawn for display.
+int ScoreToCentipawns(int score);
+
+//--------------------------------------------------------------------------------------------------
+
+//One search thread. Owns its own position and principal variation, and shares everything it
+//learns through the manager's transposition table.
+class SearchWorker
+{
+//--------------------------------------------------------------------------------------------------
+public:
+	SearchWorker(SearchManager* manager, int threadIndex);
+
+	void		Search(const Position& position, const SearchLimits& limits);
+	void		ClearHistory();
+
+	const Move& GetBestMove() const			{ return mBestMove; }
+	int			GetBestScore() const		{ return mBestScore; }
+	int			GetCompletedDepth() const	{ return mCompletedDepth; }
+	uint64_t	GetNodesSearched() const	{ return mNodesSearched.load(memory_order_relaxed); }
+	const PruningStats& GetPruningStats() const	{ return mPruningStats; }		//Only safe to read once the search has finished.
+
+//--------------------------------------------------------------------------------------------------
+protected:
+	int  IterativeDeepening(Move* bestMove);
+	int  MiniMax(int depth, Move* bestMove);
+	int  AlphaBeta(int depth, int alpha, int beta, int ply, bool allowNullMove = true);
+	int  Quiescence(int alpha, int beta, int ply);
+
+	bool OutOfTime();
+	void UpdatePrincipalVariation(const Move& move, int ply);
+	const Move* GetPrincipalVariationMove(int ply);
+
+	//Called when a quiet move causes a cutoff, so it is tried early at sibling nodes and elsewhere.
+	void UpdateQuietMoveHistory(const Move& move, int depth, int ply);
+	void ClearKillers();
+	void AgeHistory();
+
+	void OrderMoves(const Position& position, MoveList* moves, bool highToLow, const Move* hashMove = nullptr, const Move* pvMove = nullptr);
+	void ValueMoves(const Position& position, MoveList* moves);
+
+	int  ScoreTheBoard(const Position& positionToScore);
+
+private:
+	SearchManager*		mManager;
+	TranspositionTable* mTranspositionTable;	//Shared with every other thread.
+	Tablebases*			mTablebases;
+	int			   mThreadIndex;		//Thread 0 watches the clock and reports progress.
+	SearchLimits   mLimits;
+	PruningPolicy  mPruning;			//The manager's, copied at the start of each search.
+	PruningStats   mPruningStats;
+
+	MoveList	 moves;
+	MoveList	 mTablebaseRootMoves;	//The root moves that keep the tablebase result. Empty outside the tablebases.
+	Position	 mSearchPosition;		//The one position the search makes and unmakes moves on.
+	COLOUR		 mTeamColour;			//Side to move at the root - Scores are from its point of view.
+	COLOUR		 mOpponentColour;
+
+	atomic<uint64_t> mNodesSearched;	//Only this thread writes it, the manager reads it for reports.
+	bool			 mSearchAborted;	//Set when the search is stopped - Scores from then on are meaningless.
+
+	//Triangular table the current iteration builds its principal variation in.
+	Move mPVTable[kMaxSearchPly][kMaxSearchPly];
+	int	 mPVLength[kMaxSearchPly];
+
+	//Principal variation of the last completed iteration, searched first by the next one.
+	vector<Move> mPrincipalVariation;
+	bool		 mFollowingPV;
+
+	//Quiet moves that caused cutoffs, for the move picker.
+	Move		 mKillers[kMaxSearchPly][kKillersPerPly];
+	HistoryTable mHistory;
+
+	//Result of the last completed iteration.
+	Move mBestMove;
+	int	 mBestScore;
+	int	 mCompletedDepth;
+};
+
+//--------------------------------------------------------------------------------------------------
+
+class SearchManager
+{
+//--------------------------------------------------------------------------------------------------
+public:
+	SearchManager(size_t hashSizeMB, unsigned int threadCount);
+	~SearchManager();
+
+	void	 SetHashSize(size_t megabytes);
+	void	 SetThreadCount(unsigned int threadCount);		//0 uses every core.
+	void	 ClearHash();		//Also forgets every thread's move ordering history, for a new game.
+
+	//Which moves the search may skip. Takes effect from the next search.
+	void	 SetPruningPolicy(const PruningPolicy& policy)		{ mPruningPolicy = policy; }
+	const PruningPolicy& GetPruningPolicy() const				{ return mPruningPolicy; }
+
+	//Directories of Syzygy files, and the most pieces a position can have to be looked up in them.
+	void	 SetTablebasePath(const string& paths);
+	void	 SetTablebasePieceLimit(int pieceLimit)				{ mTablebases.SetPieceLimit(pieceLimit); }
+
+	//Called by the main search thread after every completed iteration. Without one, progress is
+	//written to cout.
+	void	 SetReporter(const SearchReporter& reporter)		{ mReporter = reporter; }
+	void	 Report(const SearchInfo& info);
+
+	//Blocks until the search finishes, then returns the score of the move written to bestMove.
+	int		 Search(const Position& position, const SearchLimits& limits, Move* bestMove);
+
+	//Searches on a background thread. Poll the future for the result. Only one search runs at a
+	//time - Starting another stops the last and waits for it.
+	future<SearchResult> StartSearch(const Position& position, const SearchLimits& limits);
+	void	 WaitForSearch();
+
+	void	 Stop()											{ mStop.store(true, memory_order_relaxed); }
+	bool	 IsStopping() const								{ return mStop.load(memory_order_relaxed); }
+
+	TranspositionTable*				 GetTranspositionTable()		{ return &mTranspositionTable; }
+	Tablebases*						 GetTablebases()				{ return &mTablebases; }
+	chrono::steady_clock::time_point GetStartTime() const			{ return mStartTime; }
+	uint64_t						 GetNodesSearched() const;
+	PruningStats					 GetPruningStats() const;		//Totals for the last search, once it has finished.
+
+//--------------------------------------------------------------------------------------------------
+private:
+	int		 RunSearch(const Position& position, const SearchLimits& limits, Move* bestMove);
+
+//--------------------------------------------------------------------------------------------------
+private:
+	TranspositionTable				 mTranspositionTable;
+	Tablebases						 mTablebases;
+	vector<unique_ptr<SearchWorker>> mWorkers;
+	atomic<bool>					 mStop;
+	thread							 mSearchThread;		//Runs StartSearch's searches.
+	chrono::steady_clock::time_point mStartTime;
+	SearchReporter					 mReporter;
+	PruningPolicy					 mPruningPolicy;
+};
+
+//--------------------------------------------------------------------------------------------------
+
+#endif //_CHESS_SEARCH_H
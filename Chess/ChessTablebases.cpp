@@ -0,0 +1,1144 @@
+//------------------------------------------------------------------------
+//  Syzygy endgame tablebases - WDL tables score positions inside the
+//  search, DTZ tables pick the root move that makes progress.
+//------------------------------------------------------------------------
+
+#include "ChessTablebases.h"
+#include "ChessMappedFile.h"
+#include "ChessMoveGenerator.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+
+//--------------------------------------------------------------------------------------------------
+
+//Flags stored with each table's compressed data.
+const int kTableFlagSideToMove	 = 1;		//DTZ tables only hold one side to move.
+const int kTableFlagMapped		 = 2;		//DTZ values go through a map.
+const int kTableFlagWinPlies	 = 4;		//Win distances are in plies rather than moves.
+const int kTableFlagLossPlies	 = 8;
+const int kTableFlagWide		 = 16;		//The map holds 16 bit values.
+const int kTableFlagSingleValue	 = 128;		//Every position in the table has the same value.
+
+//Outcome of a probe, besides its value.
+const int kProbeFail			 = 0;
+const int kProbeOK				 = 1;
+const int kProbeChangeSideToMove = -1;		//The DTZ table holds the other side to move.
+const int kProbeZeroingBestMove	 = 2;		//The best move is a capture or pawn move.
+
+//--------------------------------------------------------------------------------------------------
+
+//Decoding data for one side to move and, with pawns, one file of the leading pawn.
+struct PairsData
+{
+	int				 flags;
+	int				 maxSymbolLength;		//In bits, of the Huffman codes.
+	int				 minSymbolLength;
+	uint32_t		 blockCount;
+	uint64_t		 blockSize;				//In bytes.
+	uint64_t		 span;					//Values between sparse index entries.
+	const uint8_t*	 lowestSymbol;			//Lowest symbol of each code length, 16 bit little-endian.
+	const uint8_t*	 symbolTree;			//3 bytes per symbol - The pair of symbols it expands to.
+	const uint8_t*	 blockLength;			//Values in each block, less one, 16 bit little-endian.
+	uint32_t		 blockLengthSize;
+	const uint8_t*	 sparseIndex;			//6 bytes per entry - A block and an offset into it.
+	uint64_t		 sparseIndexSize;
+	const uint8_t*	 data;					//The compressed blocks.
+	vector<uint64_t> base64;				//Lowest code of each length, padded to 64 bits.
+	vector<uint8_t>	 symbolLength;			//Values each symbol expands to, less one.
+	int				 pieces[kTablebaseMaxPieces];
+	uint64_t		 groupIndex[kTablebaseMaxPieces + 1];
+	int				 groupLength[kTablebaseMaxPieces + 1];	//Zero terminated.
+	uint16_t		 mapIndex[4];			//Into the DTZ map for wins, losses, cursed wins and blessed losses.
+};
+
+//--------------------------------------------------------------------------------------------------
+
+//One .rtbw or .rtbz file. The material and layout are known from the name alone, the rest is
+//filled in when the file is first mapped.
+struct TablebaseTable
+{
+	bool		 dtz;
+	string		 path;
+	atomic<bool> ready;					//Set once a mapping has been tried, whether it worked or not.
+	MappedFile	 file;
+	const uint8_t* map;					//DTZ value maps.
+	uint64_t	 key;					//Material with the stronger side as white.
+	uint64_t	 key2;					//And as black.
+	int			 pieceCount;
+	bool		 hasPawns;
+	bool		 hasUniquePieces;
+	int			 pawnCount[2];			//The leading colour's, then the other's.
+	PairsData	 items[2][4];			//[side to move][file of the leading pawn].
+
+	TablebaseTable() : ready(false)		{ map = nullptr; }
+
+	//DTZ tables only hold one side to move.
+	PairsData* Get(int sideToMove, int file)	{ return &items[dtz ? 0 : sideToMove % 2][hasPawns ? file : 0]; }
+};
+
+//--------------------------------------------------------------------------------------------------
+
+namespace
+{
+	uint64_t ReadLittleEndian(const uint8_t* bytes, int count)
+	{
+		uint64_t value = 0;
+		for(int index = count - 1; index >= 0; index--)
+			value = (value << 8) | bytes[index];
+		return value;
+	}
+
+	uint64_t ReadBigEndian(const uint8_t* bytes, int count)
+	{
+		uint64_t value = 0;
+		for(int index = 0; index < count; index++)
+			value = (value << 8) | bytes[index];
+		return value;
+	}
+
+	//----------------------------------------------------------------------------------------------
+
+	//Files name pieces as codes 1 to 6 for white pawn to king, and 9 to 14 for black.
+	int PieceCode(COLOUR colour, PIECE piece)	{ return (colour == COLOUR_BLACK ? 8 : 0) + piece + 1; }
+	int ColourOfCode(int code)					{ return code >> 3; }
+
+	int DistanceFromA1H8(int square)			{ return RankOfSquare(square) - FileOfSquare(square); }
+	int FlipFile(int square)					{ return square ^ 7; }
+	int FlipRank(int square)					{ return square ^ 56; }
+
+	//----------------------------------------------------------------------------------------------
+
+	//4 bits per piece type per colour. Kings are always one each, so are left out.
+	uint64_t MaterialKey(const int counts[2][kNumberOfPieces])
+	{
+		uint64_t key = 0;
+		for(int colour = COLOUR_WHITE; colour <= COLOUR_BLACK; colour++)
+			for(int piece = PIECE_PAWN; piece < PIECE_KING; piece++)
+				key |= (uint64_t)counts[colour][piece] << (4 * (colour * 5 + piece));
+		return key;
+	}
+
+	uint64_t MaterialKey(const Position& position)
+	{
+		int counts[2][kNumberOfPieces];
+		for(int colour = COLOUR_WHITE; colour <= COLOUR_BLACK; colour++)
+			for(int piece = PIECE_PAWN; piece <= PIECE_KING; piece++)
+				counts[colour][piece] = CountBits(position.pieces[colour][piece]);
+		return MaterialKey(counts);
+	}
+
+	//----------------------------------------------------------------------------------------------
+
+	bool IsZeroingMove(const Position& position, const Move& move, bool* isCapture)
+	{
+		int	  fromSquare = MoveFromSquare(move);
+		int	  toSquare	 = MoveToSquare(move);
+		PIECE moving	 = position.PieceOn(fromSquare);
+
+		*isCapture = position.PieceOn(toSquare) != PIECE_NONE || (moving == PIECE_PAWN && toSquare == position.enPassantSquare);
+		return *isCapture || moving == PIECE_PAWN;
+	}
+
+	//The DTZ of the move before a capture or pawn move, which the tables can't store.
+	int DTZBeforeZeroing(int wdl)
+	{
+		switch(wdl)
+		{
+			case TABLEBASE_WIN:				return 1;
+			case TABLEBASE_CURSED_WIN:		return 101;
+			case TABLEBASE_BLESSED_LOSS:	return -101;
+			case TABLEBASE_LOSS:			return -1;
+			default:						return 0;
+		}
+	}
+
+	int Sign(int value)		{ return (value > 0) - (value < 0); }
+
+	//----------------------------------------------------------------------------------------------
+
+	//Tables for turning a placement of pieces into an index into a table.
+	struct IndexTables
+	{
+		int		 mapPawns[64];				//a2 to h7 as 0 to 47. The leading pawn has the highest value.
+		int		 mapB1H1H7[64];				//Squares below the a1-h8 diagonal as 0 to 27.
+		int		 mapA1D1D4[64];				//The a1-d1-d4 triangle as 0 to 9.
+		int		 mapKK[10][64];				//The 462 legal pairs of kings, the first in that triangle.
+		uint64_t binomial[6][64];			//[k][n] - Ways to choose k of n.
+		int		 leadPawnIndex[6][64];		//[leading pawns][square]
+		int		 leadPawnsSize[6][4];		//[leading pawns][file]
+
+		IndexTables()
+		{
+			memset(this, 0, sizeof(*this));
+
+			int code = 0;
+			for(int square = 0; square < 64; square++)
+				if(DistanceFromA1H8(square) < 0)
+					mapB1H1H7[square] = code++;
+
+			//Squares on the diagonal come after those below it.
+			vector<int> diagonal;
+			code = 0;
+			for(int square = 0; square <= 27; square++)
+			{
+				if(DistanceFromA1H8(square) < 0 && FileOfSquare(square) <= 3)
+					mapA1D1D4[square] = code++;
+				else if(DistanceFromA1H8(square) == 0 && FileOfSquare(square) <= 3)
+					diagonal.push_back(square);
+			}
+			for(int square : diagonal)
+				mapA1D1D4[square] = code++;
+
+			//With the first king on the diagonal, the second can't be above it. Pairs with both on
+			//it come last.
+			vector<pair<int, int>> bothOnDiagonal;
+			code = 0;
+			for(int index = 0; index < 10; index++)
+			{
+				for(int first = 0; first <= 27; first++)
+				{
+					//b1 is the only square that maps to 0 - Everything unmapped is 0 too.
+					if(mapA1D1D4[first] != index || (index == 0 && first != 1))
+						continue;
+
+					for(int second = 0; second < 64; second++)
+					{
+						if((KingAttacks(first) | SquareBitboard(first)) & SquareBitboard(second))
+							continue;
+						else if(DistanceFromA1H8(first) == 0 && DistanceFromA1H8(second) > 0)
+							continue;
+						else if(DistanceFromA1H8(first) == 0 && DistanceFromA1H8(second) == 0)
+							bothOnDiagonal.emplace_back(index, second);
+						else
+							mapKK[index][second] = code++;
+					}
+				}
+			}
+			for(const pair<int, int>& kings : bothOnDiagonal)
+				mapKK[kings.first][kings.second] = code++;
+
+			binomial[0][0] = 1;
+			for(int n = 1; n < 64; n++)
+				for(int k = 0; k < 6 && k <= n; k++)
+					binomial[k][n] = (k > 0 ? binomial[k - 1][n - 1] : 0) + (k < n ? binomial[k][n - 1] : 0);
+
+			//The leading pawn is the one nearest the edge, then the lowest rank. Each rank it moves
+			//up takes two squares from the rest - its own and its mirror.
+			int availableSquares = 47;
+			for(int leadPawns = 1; leadPawns <= 5; leadPawns++)
+			{
+				for(int file = 0; file <= 3; file++)
+				{
+					int index = 0;
+					for(int rank = 1; rank <= 6; rank++)
+					{
+						int square = rank * 8 + file;
+						if(leadPawns == 1)
+						{
+							mapPawns[square]		   = availableSquares--;
+							mapPawns[FlipFile(square)] = availableSquares--;
+						}
+						leadPawnIndex[leadPawns][square] = index;
+						index += (int)binomial[leadPawns - 1][mapPawns[square]];
+					}
+					leadPawnsSize[leadPawns][file] = index;
+				}
+			}
+		}
+	};
+
+	const IndexTables kIndexTables;
+
+	//----------------------------------------------------------------------------------------------
+
+	int LeftSymbol(const PairsData* pairs, int symbol)
+	{
+		const uint8_t* node = pairs->symbolTree + 3 * symbol;
+		return ((node[1] & 0xF) << 8) | node[0];
+	}
+
+	int RightSymbol(const PairsData* pairs, int symbol)
+	{
+		const uint8_t* node = pairs->symbolTree + 3 * symbol;
+		return (node[2] << 4) | (node[1] >> 4);
+	}
+
+	//----------------------------------------------------------------------------------------------
+
+	//Symbols stand for a pair of other symbols, so each expands into some number of values.
+	void SetSymbolLength(PairsData* pairs, int symbol, vector<bool>* visited)
+	{
+		(*visited)[symbol] = true;
+
+		int right = RightSymbol(pairs, symbol);
+		if(right == 0xFFF)
+			return;
+
+		int left = LeftSymbol(pairs, symbol);
+		if(!(*visited)[left])
+			SetSymbolLength(pairs, left, visited);
+		if(!(*visited)[right])
+			SetSymbolLength(pairs, right, visited);
+
+		pairs->symbolLength[symbol] = (uint8_t)(pairs->symbolLength[left] + pairs->symbolLength[right] + 1);
+	}
+
+	//----------------------------------------------------------------------------------------------
+
+	const uint8_t* SetSizes(PairsData* pairs, const uint8_t* data)
+	{
+		pairs->flags = *data++;
+
+		if(pairs->flags & kTableFlagSingleValue)
+		{
+			pairs->blockCount	   = 0;
+			pairs->span			   = 0;
+			pairs->blockLengthSize = 0;
+			pairs->sparseIndexSize = 0;
+			pairs->minSymbolLength = *data++;		//The single value.
+			return data;
+		}
+
+		//The last group's index is the table's size.
+		int		 groupCount = (int)(find(pairs->groupLength, pairs->groupLength + kTablebaseMaxPieces, 0) - pairs->groupLength);
+		uint64_t tableSize	= pairs->groupIndex[groupCount];
+
+		pairs->blockSize	   = 1ULL << *data++;
+		pairs->span			   = 1ULL << *data++;
+		pairs->sparseIndexSize = (tableSize + pairs->span - 1) / pairs->span;
+		int padding			   = *data++;
+		pairs->blockCount	   = (uint32_t)ReadLittleEndian(data, 4);
+		data += 4;
+		pairs->blockLengthSize = pairs->blockCount + padding;
+		pairs->maxSymbolLength = *data++;
+		pairs->minSymbolLength = *data++;
+		pairs->lowestSymbol	   = data;
+		pairs->base64.assign(pairs->maxSymbolLength - pairs->minSymbolLength + 1, 0);
+
+		//Longer codes have lower values, so each length's lowest code, padded to 64 bits, is at
+		//least the next length's.
+		for(int index = (int)pairs->base64.size() - 2; index >= 0; index--)
+		{
+			pairs->base64[index] = (pairs->base64[index + 1] + ReadLittleEndian(pairs->lowestSymbol + 2 * index, 2)
+								   - ReadLittleEndian(pairs->lowestSymbol + 2 * (index + 1), 2)) / 2;
+		}
+		for(size_t index = 0; index < pairs->base64.size(); index++)
+			pairs->base64[index] <<= 64 - index - pairs->minSymbolLength;
+
+		data += pairs->base64.size() * 2;
+		pairs->symbolLength.assign((size_t)ReadLittleEndian(data, 2), 0);
+		data += 2;
+		pairs->symbolTree = data;
+
+		vector<bool> visited(pairs->symbolLength.size());
+		for(size_t symbol = 0; symbol < pairs->symbolLength.size(); symbol++)
+			if(!visited[symbol])
+				SetSymbolLength(pairs, (int)symbol, &visited);
+
+		return data + pairs->symbolLength.size() * 3 + (pairs->symbolLength.size() & 1);
+	}
+
+	//----------------------------------------------------------------------------------------------
+
+	//Works out how many pieces share each group, and the order the groups are encoded in.
+	void SetGroups(TablebaseTable* table, PairsData* pairs, const int order[2], int file)
+	{
+		int groupCount	= 0;
+		int firstLength = table->hasPawns ? 0 : table->hasUniquePieces ? 3 : 2;
+		pairs->groupLength[groupCount] = 1;
+
+		for(int index = 1; index < table->pieceCount; index++)
+		{
+			if(--firstLength > 0 || pairs->pieces[index] == pairs->pieces[index - 1])
+				pairs->groupLength[groupCount]++;
+			else
+				pairs->groupLength[++groupCount] = 1;
+		}
+		pairs->groupLength[++groupCount] = 0;
+
+		bool	 pawnsOnBothSides = table->hasPawns && table->pawnCount[1] > 0;
+		int		 next			  = pawnsOnBothSides ? 2 : 1;
+		int		 freeSquares	  = 64 - pairs->groupLength[0] - (pawnsOnBothSides ? pairs->groupLength[1] : 0);
+		uint64_t index			  = 1;
+
+		for(int k = 0; next < groupCount || k == order[0] || k == order[1]; k++)
+		{
+			if(k == order[0])
+			{
+				//Leading pawns or pieces.
+				pairs->groupIndex[0] = index;
+				index *= table->hasPawns ? kIndexTables.leadPawnsSize[pairs->groupLength[0]][file] : table->hasUniquePieces ? 31332 : 462;
+			}
+			else if(k == order[1])
+			{
+				//The other side's pawns.
+				pairs->groupIndex[1] = index;
+				index *= kIndexTables.binomial[pairs->groupLength[1]][48 - pairs->groupLength[0]];
+			}
+			else
+			{
+				pairs->groupIndex[next] = index;
+				index *= kIndexTables.binomial[pairs->groupLength[next]][freeSquares];
+				freeSquares -= pairs->groupLength[next++];
+			}
+		}
+		pairs->groupIndex[groupCount] = index;
+	}
+
+	//----------------------------------------------------------------------------------------------
+
+	const uint8_t* SetDTZMap(TablebaseTable* table, const uint8_t* data, int maxFile)
+	{
+		table->map = data;
+
+		for(int file = 0; file <= maxFile; file++)
+		{
+			PairsData* pairs = table->Get(0, file);
+			if(!(pairs->flags & kTableFlagMapped))
+				continue;
+
+			if(pairs->flags & kTableFlagWide)
+			{
+				data += (uintptr_t)data & 1;
+				for(int index = 0; index < 4; index++)
+				{
+					pairs->mapIndex[index] = (uint16_t)((data - table->map) / 2 + 1);
+					data += 2 * ReadLittleEndian(data, 2) + 2;
+				}
+			}
+			else
+			{
+				for(int index = 0; index < 4; index++)
+				{
+					pairs->mapIndex[index] = (uint16_t)(data - table->map + 1);
+					data += *data + 1;
+				}
+			}
+		}
+		return data + ((uintptr_t)data & 1);
+	}
+
+	//----------------------------------------------------------------------------------------------
+
+	//Reads the header that follows the magic number, and points each PairsData into the file.
+	void InitTable(TablebaseTable* table, const uint8_t* data)
+	{
+		data++;		//Flags - has pawns and split, both already known from the name.
+
+		int	 sides			  = !table->dtz && table->key != table->key2 ? 2 : 1;
+		int	 maxFile		  = table->hasPawns ? 3 : 0;
+		bool pawnsOnBothSides = table->hasPawns && table->pawnCount[1] > 0;
+
+		for(int file = 0; file <= maxFile; file++)
+		{
+			for(int side = 0; side < sides; side++)
+				*table->Get(side, file) = PairsData();
+
+			int order[2][2] = {{*data & 0xF, pawnsOnBothSides ? *(data + 1) & 0xF : 0xF},
+							   {*data >> 4,	 pawnsOnBothSides ? *(data + 1) >> 4  : 0xF}};
+			data += 1 + pawnsOnBothSides;
+
+			for(int piece = 0; piece < table->pieceCount; piece++, data++)
+				for(int side = 0; side < sides; side++)
+					table->Get(side, file)->pieces[piece] = side ? *data >> 4 : *data & 0xF;
+
+			for(int side = 0; side < sides; side++)
+				SetGroups(table, table->Get(side, file), order[side], file);
+		}
+		data += (uintptr_t)data & 1;
+
+		for(int file = 0; file <= maxFile; file++)
+			for(int side = 0; side < sides; side++)
+				data = SetSizes(table->Get(side, file), data);
+
+		if(table->dtz)
+			data = SetDTZMap(table, data, maxFile);
+
+		for(int file = 0; file <= maxFile; file++)
+		{
+			for(int side = 0; side < sides; side++)
+			{
+				PairsData* pairs   = table->Get(side, file);
+				pairs->sparseIndex = data;
+				data += pairs->sparseIndexSize * 6;
+			}
+		}
+
+		for(int file = 0; file <= maxFile; file++)
+		{
+			for(int side = 0; side < sides; side++)
+			{
+				PairsData* pairs   = table->Get(side, file);
+				pairs->blockLength = data;
+				data += pairs->blockLengthSize * 2;
+			}
+		}
+
+		for(int file = 0; file <= maxFile; file++)
+		{
+			for(int side = 0; side < sides; side++)
+			{
+				//Blocks start on 64 byte boundaries.
+				data = (const uint8_t*)(((uintptr_t)data + 0x3F) & ~(uintptr_t)0x3F);
+
+				PairsData* pairs = table->Get(side, file);
+				pairs->data		 = data;
+				data += pairs->blockCount * pairs->blockSize;
+			}
+		}
+	}
+
+	//----------------------------------------------------------------------------------------------
+
+	//Finds the value at an index. Values are Huffman coded symbols, each standing for a run of
+	//values built up by pairing, in blocks with a sparse index to find the right one quickly.
+	int DecompressPairs(const PairsData* pairs, uint64_t index)
+	{
+		if(pairs->flags & kTableFlagSingleValue)
+			return pairs->minSymbolLength;
+
+		//The sparse index points to the middle of every span'th value.
+		uint32_t k		= (uint32_t)(index / pairs->span);
+		uint32_t block	= (uint32_t)ReadLittleEndian(pairs->sparseIndex + 6 * k, 4);
+		int		 offset = (int)ReadLittleEndian(pairs->sparseIndex + 6 * k + 4, 2);
+
+		offset += (int)(index % pairs->span) - (int)(pairs->span / 2);
+
+		while(offset < 0)
+			offset += (int)ReadLittleEndian(pairs->blockLength + 2 * --block, 2) + 1;
+		while(offset > (int)ReadLittleEndian(pairs->blockLength + 2 * block, 2))
+			offset -= (int)ReadLittleEndian(pairs->blockLength + 2 * block++, 2) + 1;
+
+		//Walk the block's symbols until the one holding the offset.
+		const uint8_t* bytes	  = pairs->data + (uint64_t)block * pairs->blockSize;
+		uint64_t	   buffer	  = ReadBigEndian(bytes, 8);
+		int			   bufferBits = 64;
+		int			   symbol;
+		bytes += 8;
+
+		while(true)
+		{
+			int length = 0;
+			while(buffer < pairs->base64[length])
+				length++;
+
+			symbol = (int)((buffer - pairs->base64[length]) >> (64 - length - pairs->minSymbolLength));
+			symbol = (symbol + (int)ReadLittleEndian(pairs->lowestSymbol + 2 * length, 2)) & 0xFFFF;
+
+			if(offset < pairs->symbolLength[symbol] + 1)
+				break;
+
+			offset -= pairs->symbolLength[symbol] + 1;
+			length += pairs->minSymbolLength;
+			buffer <<= length;
+			bufferBits -= length;
+
+			if(bufferBits <= 32)
+			{
+				bufferBits += 32;
+				buffer |= ReadBigEndian(bytes, 4) << (64 - bufferBits);
+				bytes += 4;
+			}
+		}
+
+		//Expand the symbol's pairs down to the single value.
+		while(pairs->symbolLength[symbol])
+		{
+			int left = LeftSymbol(pairs, symbol);
+			if(offset < pairs->symbolLength[left] + 1)
+			{
+				symbol = left;
+			}
+			else
+			{
+				offset -= pairs->symbolLength[left] + 1;
+				symbol = RightSymbol(pairs, symbol);
+			}
+		}
+		return LeftSymbol(pairs, symbol);
+	}
+
+	//----------------------------------------------------------------------------------------------
+
+	int MapScore(TablebaseTable* table, int file, int value, int wdl)
+	{
+		if(!table->dtz)
+			return value - 2;
+
+		static const int kWDLMap[] = {1, 3, 0, 2, 0};
+
+		const PairsData* pairs = table->Get(0, file);
+		if(pairs->flags & kTableFlagMapped)
+		{
+			int mapIndex = pairs->mapIndex[kWDLMap[wdl + 2]] + value;
+			if(pairs->flags & kTableFlagWide)
+				value = (int)ReadLittleEndian(table->map + 2 * mapIndex, 2);
+			else
+				value = table->map[mapIndex];
+		}
+
+		//Distances are stored in moves or plies. Plies are wanted.
+		if((wdl == TABLEBASE_WIN && !(pairs->flags & kTableFlagWinPlies)) || (wdl == TABLEBASE_LOSS && !(pairs->flags & kTableFlagLossPlies))
+		   || wdl == TABLEBASE_CURSED_WIN || wdl == TABLEBASE_BLESSED_LOSS)
+			value *= 2;
+
+		return value + 1;
+	}
+
+	//----------------------------------------------------------------------------------------------
+
+	//Turns the position into an index into the table, and reads the value there.
+	int ProbeMappedTable(const Position& position, TablebaseTable* table, uint64_t materialKey, int wdl, int* state)
+	{
+		int		 squares[kTablebaseMaxPieces];
+		int		 pieces[kTablebaseMaxPieces];
+		int		 size			 = 0;
+		int		 leadPawnCount	 = 0;
+		int		 leadFile		 = 0;
+		Bitboard leadPawns		 = 0;
+		uint64_t index;
+
+		auto pawnOrder = [](int a, int b)
+		{
+			return kIndexTables.mapPawns[a] < kIndexTables.mapPawns[b];
+		};
+
+		//Tables are built with the stronger side as white. A symmetric table only holds white to
+		//move. Either way the colours might need swapping and the board flipping.
+		bool symmetricBlackToMove = table->key == table->key2 && position.sideToMove == COLOUR_BLACK;
+		bool blackStronger		  = materialKey != table->key;
+		bool flip				  = symmetricBlackToMove || blackStronger;
+		int	 flipColour			  = flip ? 8 : 0;
+		int	 flipSquares		  = flip ? 56 : 0;
+		int	 sideToMove			  = (flip ? 1 : 0) ^ position.sideToMove;
+
+		//With pawns there is a table per file of the leading pawn, which comes first.
+		if(table->hasPawns)
+		{
+			int code  = table->Get(0, 0)->pieces[0] ^ flipColour;
+			leadPawns = position.pieces[ColourOfCode(code)][PIECE_PAWN];
+
+			Bitboard pawns = leadPawns;
+			while(pawns)
+				squares[size++] = PopLowestBit(&pawns) ^ flipSquares;
+			leadPawnCount = size;
+
+			swap(squares[0], *max_element(squares, squares + leadPawnCount, pawnOrder));
+			leadFile = min(FileOfSquare(squares[0]), 7 - FileOfSquare(squares[0]));
+		}
+
+		//DTZ tables only hold one side to move. The caller searches a ply to find the other.
+		if(table->dtz)
+		{
+			int flags = table->Get(sideToMove, leadFile)->flags;
+			if((flags & kTableFlagSideToMove) != sideToMove && !(table->key == table->key2 && !table->hasPawns))
+			{
+				*state = kProbeChangeSideToMove;
+				return 0;
+			}
+		}
+
+		Bitboard others = position.occupancy[COLOUR_NONE] ^ leadPawns;
+		while(others)
+		{
+			int square		= PopLowestBit(&others);
+			squares[size]	= square ^ flipSquares;
+			pieces[size++]	= PieceCode(position.ColourOn(square), position.PieceOn(square)) ^ flipColour;
+		}
+
+		//Put the pieces in the table's order.
+		PairsData* pairs = table->Get(sideToMove, leadFile);
+		for(int i = leadPawnCount; i < size - 1; i++)
+		{
+			for(int j = i + 1; j < size; j++)
+			{
+				if(pairs->pieces[i] == pieces[j])
+				{
+					swap(pieces[i], pieces[j]);
+					swap(squares[i], squares[j]);
+					break;
+				}
+			}
+		}
+
+		//The leading piece goes on the a to d files.
+		if(FileOfSquare(squares[0]) > 3)
+			for(int i = 0; i < size; i++)
+				squares[i] = FlipFile(squares[i]);
+
+		if(table->hasPawns)
+		{
+			index = kIndexTables.leadPawnIndex[leadPawnCount][squares[0]];
+
+			stable_sort(squares + 1, squares + leadPawnCount, pawnOrder);
+			for(int i = 1; i < leadPawnCount; i++)
+				index += kIndexTables.binomial[i][kIndexTables.mapPawns[squares[i]]];
+		}
+		else
+		{
+			//Without pawns, the leading piece also goes below the 5th rank, then below the a1-h8
+			//diagonal.
+			if(RankOfSquare(squares[0]) > 3)
+				for(int i = 0; i < size; i++)
+					squares[i] = FlipRank(squares[i]);
+
+			for(int i = 0; i < pairs->groupLength[0]; i++)
+			{
+				if(!DistanceFromA1H8(squares[i]))
+					continue;
+
+				if(DistanceFromA1H8(squares[i]) > 0)
+					for(int j = i; j < size; j++)
+						squares[j] = ((squares[j] >> 3) | (squares[j] << 3)) & 63;
+				break;
+			}
+
+			//Three unique pieces, kings included, are encoded together. Otherwise just the kings.
+			if(table->hasUniquePieces)
+			{
+				int adjust1 = squares[1] > squares[0];
+				int adjust2 = (squares[2] > squares[0]) + (squares[2] > squares[1]);
+
+				if(DistanceFromA1H8(squares[0]))
+				{
+					index = ((uint64_t)kIndexTables.mapA1D1D4[squares[0]] * 63 + (squares[1] - adjust1)) * 62 + squares[2] - adjust2;
+				}
+				else if(DistanceFromA1H8(squares[1]))
+				{
+					index = ((uint64_t)6 * 63 + RankOfSquare(squares[0]) * 28 + kIndexTables.mapB1H1H7[squares[1]]) * 62 + squares[2] - adjust2;
+				}
+				else if(DistanceFromA1H8(squares[2]))
+				{
+					index = 6 * 63 * 62 + 4 * 28 * 62 + RankOfSquare(squares[0]) * 7 * 28 + (RankOfSquare(squares[1]) - adjust1) * 28
+						  + kIndexTables.mapB1H1H7[squares[2]];
+				}
+				else
+				{
+					index = 6 * 63 * 62 + 4 * 28 * 62 + 4 * 7 * 28 + RankOfSquare(squares[0]) * 7 * 6 + (RankOfSquare(squares[1]) - adjust1) * 6
+						  + (RankOfSquare(squares[2]) - adjust2);
+				}
+			}
+			else
+			{
+				index = kIndexTables.mapKK[kIndexTables.mapA1D1D4[squares[0]]][squares[1]];
+			}
+		}
+
+		//Then each remaining group in turn, squares counted past those already taken.
+		index *= pairs->groupIndex[0];
+		int* groupSquares	= squares + pairs->groupLength[0];
+		bool remainingPawns = table->hasPawns && table->pawnCount[1] > 0;
+
+		for(int next = 1; pairs->groupLength[next]; next++)
+		{
+			stable_sort(groupSquares, groupSquares + pairs->groupLength[next]);
+
+			uint64_t groupValue = 0;
+			for(int i = 0; i < pairs->groupLength[next]; i++)
+			{
+				int adjust = (int)count_if(squares, groupSquares, [&](int square) { return groupSquares[i] > square; });
+				groupValue += kIndexTables.binomial[i + 1][groupSquares[i] - adjust - (remainingPawns ? 8 : 0)];
+			}
+
+			remainingPawns = false;
+			index += groupValue * pairs->groupIndex[next];
+			groupSquares += pairs->groupLength[next];
+		}
+
+		return MapScore(table, leadFile, DecompressPairs(pairs, index), wdl);
+	}
+}
+
+//--------------------------------------------------------------------------------------------------
+
+Tablebases::Tablebases()
+{
+	mPieceLimit	  = kTablebaseMaxPieces;
+	mLargestTable = 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+Tablebases::~Tablebases()
+{
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void Tablebases::SetPath(const string& paths)
+{
+	mEntries.clear();
+	mTables.clear();
+	mLargestTable = 0;
+
+#ifdef _WIN32
+	const char kSeparator = ';';
+#else
+	const char kSeparator = ':';
+#endif
+
+	vector<string> directories;
+	size_t		   start = 0;
+	while(start <= paths.size())
+	{
+		size_t end = paths.find(kSeparator, start);
+		if(end == string::npos)
+			end = paths.size();
+		if(end > start)
+			directories.push_back(paths.substr(start, end - start));
+		start = end + 1;
+	}
+
+	//Missing or unreadable directories are skipped.
+	for(const string& directory : directories)
+	{
+		error_code error;
+		for(filesystem::directory_iterator file(directory, error), last; !error && file != last; file.increment(error))
+			if(file->path().extension() == ".rtbw")
+				AddTable(directories, file->path().stem().string());
+	}
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void Tablebases::AddTable(const vector<string>& directories, const string& name)
+{
+	//Names list the stronger side's pieces then the weaker's, kings first, e.g. KRPvKR.
+	size_t split = name.find('v');
+	if(split == string::npos || name.size() - 1 > (size_t)kTablebaseMaxPieces)
+		return;
+
+	int counts[2][kNumberOfPieces] = {};
+	for(size_t index = 0; index < name.size(); index++)
+	{
+		if(index == split)
+			continue;
+
+		size_t piece = string("PNBRQK").find(name[index]);
+		if(piece == string::npos)
+			return;
+		counts[index < split ? COLOUR_WHITE : COLOUR_BLACK][piece]++;
+	}
+	if(counts[COLOUR_WHITE][PIECE_KING] != 1 || counts[COLOUR_BLACK][PIECE_KING] != 1)
+		return;
+
+	uint64_t key = MaterialKey(counts);
+	if(mEntries.count(key))
+		return;
+
+	int swapped[2][kNumberOfPieces];
+	for(int piece = PIECE_PAWN; piece <= PIECE_KING; piece++)
+	{
+		swapped[COLOUR_WHITE][piece] = counts[COLOUR_BLACK][piece];
+		swapped[COLOUR_BLACK][piece] = counts[COLOUR_WHITE][piece];
+	}
+
+	TableEntry entry = {nullptr, nullptr};
+	for(int dtz = 0; dtz <= 1; dtz++)
+	{
+		string fileName = name + (dtz ? ".rtbz" : ".rtbw");
+		for(const string& directory : directories)
+		{
+			error_code error;
+			filesystem::path path = filesystem::path(directory) / fileName;
+			if(!filesystem::exists(path, error))
+				continue;
+
+			unique_ptr<TablebaseTable> table = make_unique<TablebaseTable>();
+			table->dtz		  = dtz != 0;
+			table->path		  = path.string();
+			table->key		  = key;
+			table->key2		  = MaterialKey(swapped);
+			table->pieceCount = (int)name.size() - 1;
+			table->hasPawns	  = counts[COLOUR_WHITE][PIECE_PAWN] + counts[COLOUR_BLACK][PIECE_PAWN] > 0;
+
+			table->hasUniquePieces = false;
+			for(int colour = COLOUR_WHITE; colour <= COLOUR_BLACK; colour++)
+				for(int piece = PIECE_PAWN; piece < PIECE_KING; piece++)
+					if(counts[colour][piece] == 1)
+						table->hasUniquePieces = true;
+
+			//Pawns lead from the side with fewer of them, which packs better.
+			int	 whitePawns = counts[COLOUR_WHITE][PIECE_PAWN];
+			int	 blackPawns = counts[COLOUR_BLACK][PIECE_PAWN];
+			bool whiteLeads = blackPawns == 0 || (whitePawns > 0 && blackPawns >= whitePawns);
+			table->pawnCount[0] = whiteLeads ? whitePawns : blackPawns;
+			table->pawnCount[1] = whiteLeads ? blackPawns : whitePawns;
+
+			(dtz ? entry.dtz : entry.wdl) = table.get();
+			mTables.push_back(move(table));
+			break;
+		}
+	}
+
+	if(entry.wdl == nullptr)
+		return;
+
+	mEntries[entry.wdl->key]  = entry;
+	mEntries[entry.wdl->key2] = entry;
+	mLargestTable = max(mLargestTable, entry.wdl->pieceCount);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+bool Tablebases::MapTable(TablebaseTable* table)
+{
+	if(table->ready.load(memory_order_acquire))
+		return table->file.IsOpen();
+
+	lock_guard<mutex> lock(mMapMutex);
+	if(table->ready.load(memory_order_relaxed))
+		return table->file.IsOpen();
+
+	//A 4 byte magic number, then data padded to 64 bytes. Anything else is corrupt.
+	static const uint8_t kMagic[2][4] = {{0x71, 0xE8, 0x23, 0x5D}, {0xD7, 0x66, 0x0C, 0xA5}};
+
+	if(table->file.Open(table->path))
+	{
+		if(table->file.GetSize() % 64 == 16 && memcmp(table->file.GetData(), kMagic[table->dtz], 4) == 0)
+			InitTable(table, table->file.GetData() + 4);
+		else
+			table->file.Close();
+	}
+
+	table->ready.store(true, memory_order_release);
+	return table->file.IsOpen();
+}
+
+//--------------------------------------------------------------------------------------------------
+
+bool Tablebases::CanProbe(const Position& position) const
+{
+	if(position.castlingRights != CASTLE_NONE)
+		return false;
+
+	return CountBits(position.occupancy[COLOUR_NONE]) <= min(mPieceLimit, mLargestTable);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+bool Tablebases::ProbeWDL(Position& position, int* wdl)
+{
+	if(!CanProbe(position))
+		return false;
+
+	int state = kProbeOK;
+	int value = SearchZeroingMoves(position, false, &state);
+	if(state == kProbeFail)
+		return false;
+
+	*wdl = value;
+	return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+bool Tablebases::ProbeDTZ(Position& position, int* dtz)
+{
+	if(!CanProbe(position))
+		return false;
+
+	int state = kProbeOK;
+	int value = ProbeDistanceToZero(position, &state);
+	if(state == kProbeFail)
+		return false;
+
+	*dtz = value;
+	return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+bool Tablebases::FilterRootMoves(Position& position, MoveList* moves)
+{
+	if(!CanProbe(position) || moves->Empty())
+		return false;
+
+	//There is no fifty move rule or repetition here, so the quickest win is always taken to be
+	//sure of progress, and the slowest loss to give the opponent the most chances to go wrong.
+	const int kMaxDTZ = 1 << 12;
+	vector<int> ranks;
+	int			bestRank = -2 * kMaxDTZ;
+	int			state	 = kProbeOK;
+
+	for(const Move& move : *moves)
+	{
+		bool isCapture;
+		bool zeroing = IsZeroingMove(position, move, &isCapture);
+		int	 dtz;
+
+		position.MakeMove(move);
+		if(zeroing)
+		{
+			dtz = DTZBeforeZeroing(-SearchZeroingMoves(position, false, &state));
+		}
+		else
+		{
+			dtz = -ProbeDistanceToZero(position, &state);
+			dtz += Sign(dtz);
+		}
+
+		//Mate is as quick as it gets.
+		if(dtz == 2 && GetGameState(position) == GAMESTATE_CHECKMATE)
+			dtz = 1;
+		position.UnMakeMove();
+
+		if(state == kProbeFail)
+			return false;
+
+		int rank = dtz > 0 ? kMaxDTZ - dtz : dtz < 0 ? -kMaxDTZ - dtz : 0;
+		ranks.push_back(rank);
+		bestRank = max(bestRank, rank);
+	}
+
+	int kept = 0;
+	for(int index = 0; index < moves->Size(); index++)
+		if(ranks[index] == bestRank)
+			(*moves)[kept++] = (*moves)[index];
+	moves->Resize(kept);
+	return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+int Tablebases::ProbeTable(const Position& position, bool dtz, int wdl, int* state)
+{
+	//Bare kings.
+	if(CountBits(position.occupancy[COLOUR_NONE]) == 2)
+		return TABLEBASE_DRAW;
+
+	uint64_t materialKey = MaterialKey(position);
+	auto	 found		 = mEntries.find(materialKey);
+
+	TablebaseTable* table = found == mEntries.end() ? nullptr : dtz ? found->second.dtz : found->second.wdl;
+	if(table == nullptr || !MapTable(table))
+	{
+		*state = kProbeFail;
+		return 0;
+	}
+
+	return ProbeMappedTable(position, table, materialKey, wdl, state);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+//Tables are built without en'passant, and can hold anything for positions where a capture wins,
+//so captures - and for DTZ, pawn moves too - are searched before trusting the table.
+int Tablebases::SearchZeroingMoves(Position& position, bool includePawnMoves, int* state)
+{
+	MoveList moves;
+	GenerateMoves(position, &moves);
+
+	int bestValue = TABLEBASE_LOSS;
+	int zeroingMoveCount = 0;
+
+	for(const Move& move : moves)
+	{
+		bool isCapture;
+		bool zeroing = IsZeroingMove(position, move, &isCapture);
+		if(!isCapture && !(includePawnMoves && zeroing))
+			continue;
+
+		zeroingMoveCount++;
+
+		position.MakeMove(move);
+		int value = -SearchZeroingMoves(position, false, state);
+		position.UnMakeMove();
+
+		if(*state == kProbeFail)
+			return TABLEBASE_DRAW;
+
+		if(value > bestValue)
+		{
+			bestValue = value;
+			if(value >= TABLEBASE_WIN)
+			{
+				*state = kProbeZeroingBestMove;
+				return value;
+			}
+		}
+	}
+
+	//With every move searched, the table isn't needed - and might be wrong, if en'passant was
+	//one of them.
+	bool noMoreMoves = zeroingMoveCount > 0 && zeroingMoveCount == moves.Size();
+	int	 value;
+
+	if(noMoreMoves)
+	{
+		value = bestValue;
+	}
+	else
+	{
+		value = ProbeTable(position, false, TABLEBASE_DRAW, state);
+		if(*state == kProbeFail)
+			return TABLEBASE_DRAW;
+	}
+
+	if(bestValue >= value)
+	{
+		*state = bestValue > TABLEBASE_DRAW || noMoreMoves ? kProbeZeroingBestMove : kProbeOK;
+		return bestValue;
+	}
+
+	*state = kProbeOK;
+	return value;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+//Plies to the next capture or pawn move on the best path, positive when winning. 0 for a draw.
+int Tablebases::ProbeDistanceToZero(Position& position, int* state)
+{
+	*state	= kProbeOK;
+	int wdl = SearchZeroingMoves(position, true, state);
+
+	//DTZ tables don't store draws.
+	if(*state == kProbeFail || wdl == TABLEBASE_DRAW)
+		return 0;
+
+	//When a capture or pawn move is best, the table's value is meaningless.
+	if(*state == kProbeZeroingBestMove)
+		return DTZBeforeZeroing(wdl);
+
+	int dtz = ProbeTable(position, true, wdl, state);
+	if(*state == kProbeFail)
+		return 0;
+
+	if(*state != kProbeChangeSideToMove)
+		return (dtz + 100 * (wdl == TABLEBASE_BLESSED_LOSS || wdl == TABLEBASE_CURSED_WIN)) * Sign(wdl);
+
+	//The table holds the other side to move, so search a ply for the move with the best DTZ.
+	MoveList moves;
+	GenerateMoves(position, &moves);
+
+	int minDTZ = 0xFFFF;
+	for(const Move& move : moves)
+	{
+		bool isCapture;
+		bool zeroing = IsZeroingMove(position, move, &isCapture);
+
+		position.MakeMove(move);
+		dtz = zeroing ? -DTZBeforeZeroing(SearchZeroingMoves(position, false, state)) : -ProbeDistanceToZero(position, state);
+
+		if(dtz == 1 && GetGameState(position) == GAMESTATE_CHECKMATE)
+			minDTZ = 1;
+
+		if(!zeroing)
+			dtz += Sign(dtz);
+
+		if(dtz < minDTZ && Sign(dtz) == Sign(wdl))
+			minDTZ = dtz;
+		position.UnMakeMove();
+
+		if(*state == kProbeFail)
+			return 0;
+	}
+
+	//No legal moves - Mated.
+	return minDTZ == 0xFFFF ? -1 : minDTZ;
+}
+
+//--------------------------------------------------------------------------------------------------
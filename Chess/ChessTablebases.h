@@ -0,0 +1,102 @@
+//------------------------------------------------------------------------
+//  Syzygy endgame tablebases - WDL tables score positions inside the
+//  search, DTZ tables pick the root move that makes progress.
+//------------------------------------------------------------------------
+
+#ifndef _CHESS_TABLEBASES_H
+#define _CHESS_TABLEBASES_H
+
+#include "ChessCommons.h"
+#include "ChessMoveList.h"
+#include "ChessPosition.h"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+struct TablebaseTable;
+
+//--------------------------------------------------------------------------------------------------
+
+//Most pieces, kings included, of any Syzygy table.
+const int kTablebaseMaxPieces = 7;
+
+//--------------------------------------------------------------------------------------------------
+
+//Results of a WDL probe, for the side to move. Cursed wins and blessed losses are only drawn by
+//the fifty move rule.
+enum TABLEBASE_WDL
+{
+	TABLEBASE_LOSS			= -2,
+	TABLEBASE_BLESSED_LOSS	= -1,
+	TABLEBASE_DRAW			= 0,
+	TABLEBASE_CURSED_WIN	= 1,
+	TABLEBASE_WIN			= 2
+};
+
+//--------------------------------------------------------------------------------------------------
+
+class Tablebases
+{
+//--------------------------------------------------------------------------------------------------
+public:
+	Tablebases();
+	~Tablebases();
+
+	Tablebases(const Tablebases&)			 = delete;
+	Tablebases& operator=(const Tablebases&) = delete;
+
+	//Directories holding .rtbw and .rtbz files, separated as in the PATH variable. Only the
+	//names are read here - Each file is mapped the first time a position needs it. An empty
+	//string turns probing off. Never call while a search is running.
+	void	 SetPath(const string& paths);
+
+	//Positions with more pieces than this, kings included, are searched as normal.
+	void	 SetPieceLimit(int pieceLimit)		{ mPieceLimit = pieceLimit; }
+	int		 GetPieceLimit() const				{ return mPieceLimit; }
+
+	size_t	 GetTableCount() const				{ return mTables.size(); }
+	int		 GetLargestTable() const			{ return mLargestTable; }
+
+	//Tables know nothing of castling, so positions that still have the right are never probed.
+	bool	 CanProbe(const Position& position) const;
+
+	//Moves are made and unmade on the position while probing, so it must not be shared. Both
+	//return false if a table is missing or the position is out of range.
+	bool	 ProbeWDL(Position& position, int* wdl);
+	bool	 ProbeDTZ(Position& position, int* dtz);
+
+	//Cuts the root moves down to those that keep the best result, the quickest win first. Returns
+	//false, leaving the moves alone, if the position can't be probed.
+	bool	 FilterRootMoves(Position& position, MoveList* moves);
+
+//--------------------------------------------------------------------------------------------------
+private:
+	struct TableEntry
+	{
+		TablebaseTable* wdl;
+		TablebaseTable* dtz;		//nullptr if only the WDL file was found.
+	};
+
+	void	 AddTable(const vector<string>& directories, const string& name);
+	bool	 MapTable(TablebaseTable* table);
+
+	int		 ProbeTable(const Position& position, bool dtz, int wdl, int* state);
+	int		 SearchZeroingMoves(Position& position, bool includePawnMoves, int* state);
+	int		 ProbeDistanceToZero(Position& position, int* state);
+
+//--------------------------------------------------------------------------------------------------
+private:
+	vector<unique_ptr<TablebaseTable>>	 mTables;
+	unordered_map<uint64_t, TableEntry>	 mEntries;		//Keyed by material, for either colour.
+	mutex								 mMapMutex;		//Threads probing the same unmapped table wait for one to map it.
+	int									 mPieceLimit;
+	int									 mLargestTable;
+};
+
+//--------------------------------------------------------------------------------------------------
+
+#endif //_CHESS_TABLEBASES_H
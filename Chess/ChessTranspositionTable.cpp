@@ -0,0 +1,174 @@
+//------------------------------------------------------------------------
+//  Fixed-size hash table of previously searched positions.
+//------------------------------------------------------------------------
+
+#include "ChessTranspositionTable.h"
+
+//--------------------------------------------------------------------------------------------------
+
+namespace
+{
+	//Layout of an entry's data word, from the lowest bit up.
+	const int	   kScoreShift		= 0;	//32 bits, two's complement.
+	const int	   kDepthShift		= 32;	//8 bits.
+	const int	   kBoundShift		= 40;	//2 bits.
+	const int	   kAgeShift		= 42;	//6 bits.
+	const int	   kMoveShift		= 48;	//16 bits, as Move packs them.
+	const uint64_t kAgeMask			= 0x3F;
+
+	uint64_t PackEntry(const TTEntry& entry)
+	{
+		return ((uint64_t)(uint32_t)entry.score		  << kScoreShift)  |
+			   ((uint64_t)(entry.depth & 0xFF)		  << kDepthShift)  |
+			   ((uint64_t)(entry.bound & 0x3)		  << kBoundShift)  |
+			   ((uint64_t)(entry.age & kAgeMask)	  << kAgeShift)	   |
+			   ((uint64_t)entry.bestMove.data		  << kMoveShift);
+	}
+
+	//----------------------------------------------------------------------------------------------
+
+	void UnpackEntry(uint64_t data, TTEntry* entry)
+	{
+		entry->score			 = (int)(int32_t)(uint32_t)(data >> kScoreShift);
+		entry->depth			 = (short)((data >> kDepthShift) & 0xFF);
+		entry->bound			 = (unsigned char)((data >> kBoundShift) & 0x3);
+		entry->age				 = (unsigned char)((data >> kAgeShift) & kAgeMask);
+		entry->bestMove.data	 = (uint16_t)(data >> kMoveShift);
+	}
+}
+
+//--------------------------------------------------------------------------------------------------
+
+TranspositionTable::TranspositionTable(size_t megabytes)
+{
+	mBucketCount = 0;
+	mAge		 = 0;
+	Resize(megabytes);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void TranspositionTable::Resize(size_t megabytes)
+{
+	//Largest power of two number of buckets that fits, so the index is a mask rather than a modulo.
+	size_t bucketCount = 1;
+	while(bucketCount * 2 * sizeof(TTBucket) <= megabytes * 1024 * 1024)
+		bucketCount *= 2;
+
+	if(bucketCount != mBucketCount)
+	{
+		mBuckets.reset(new TTBucket[bucketCount]);
+		mBucketCount = bucketCount;
+		mIndexMask	 = bucketCount - 1;
+	}
+
+	Clear();
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void TranspositionTable::Clear()
+{
+	for(size_t index = 0; index < mBucketCount; index++)
+	{
+		mBuckets[index].depthPreferred.check.store(0, memory_order_relaxed);
+		mBuckets[index].depthPreferred.data.store(0, memory_order_relaxed);
+		mBuckets[index].alwaysReplace.check.store(0, memory_order_relaxed);
+		mBuckets[index].alwaysReplace.data.store(0, memory_order_relaxed);
+	}
+	mAge = 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void TranspositionTable::NewSearch()
+{
+	//Entries from earlier searches become fair game for replacement.
+	mAge = (mAge + 1) & kAgeMask;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+bool TranspositionTable::ReadSlot(const TTSlot& slot, uint64_t key, TTEntry* entry) const
+{
+	uint64_t data = slot.data.load(memory_order_relaxed);
+	if((slot.check.load(memory_order_relaxed) ^ data) != key)
+		return false;
+
+	UnpackEntry(data, entry);
+	entry->key = key;
+	return entry->bound != TT_BOUND_NONE;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+bool TranspositionTable::Probe(uint64_t key, TTEntry* entry) const
+{
+	const TTBucket& bucket = mBuckets[key & mIndexMask];
+
+	return ReadSlot(bucket.depthPreferred, key, entry) || ReadSlot(bucket.alwaysReplace, key, entry);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void TranspositionTable::Store(uint64_t key, int depth, TT_BOUND bound, int score, const Move* bestMove)
+{
+	TTBucket& bucket = mBuckets[key & mIndexMask];
+
+	//Another thread may be writing the same bucket, so decide from a snapshot.
+	TTEntry existing;
+	bool	sameKey = ReadSlot(bucket.depthPreferred, key, &existing);
+	if(!sameKey)
+		UnpackEntry(bucket.depthPreferred.data.load(memory_order_relaxed), &existing);
+
+	//Deeper results, or anything left over from a previous search, take the depth-preferred slot.
+	TTSlot* slot = &bucket.alwaysReplace;
+	if(sameKey || existing.bound == TT_BOUND_NONE || existing.age != mAge || depth >= existing.depth)
+		slot = &bucket.depthPreferred;
+	else
+		sameKey = ReadSlot(bucket.alwaysReplace, key, &existing);
+
+	TTEntry entry;
+	entry.score = score;
+	entry.depth = (short)depth;
+	entry.bound = (unsigned char)bound;
+	entry.age	= mAge;
+
+	//Keep the previous best move if this search of the same position did not find one.
+	if(bestMove != nullptr)
+		entry.bestMove = *bestMove;
+	else if(sameKey)
+		entry.bestMove = existing.bestMove;
+	else
+		entry.bestMove = Move();
+
+	uint64_t data = PackEntry(entry);
+	slot->check.store(key ^ data, memory_order_relaxed);
+	slot->data.store(data, memory_order_relaxed);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+int TranspositionTable::ScoreToTable(int score, int ply)
+{
+	if(score > kMateThreshold)
+		return score + ply;
+	if(score < -kMateThreshold)
+		return score - ply;
+
+	return score;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+int TranspositionTable::ScoreFromTable(int score, int ply)
+{
+	if(score > kMateThreshold)
+		return score - ply;
+	if(score < -kMateThreshold)
+		return score + ply;
+
+	return score;
+}
+
+//--------------------------------------------------------------------------------------------------
@@ -0,0 +1,88 @@
+//------------------------------------------------------------------------
+//  Fixed-size hash table of previously searched positions.
+//------------------------------------------------------------------------
+
+#ifndef _CHESS_TRANSPOSITIONTABLE_H
+#define _CHESS_TRANSPOSITIONTABLE_H
+
+#include "ChessCommons.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+using namespace std;
+
+//--------------------------------------------------------------------------------------------------
+
+enum TT_BOUND
+{
+	TT_BOUND_NONE,
+	TT_BOUND_EXACT,		//Score is the true value of the position.
+	TT_BOUND_LOWER,		//Search failed high - The true value is at least the score.
+	TT_BOUND_UPPER		//Search failed low - The true value is at most the score.
+};
+
+//--------------------------------------------------------------------------------------------------
+
+//Unpacked copy of a table entry, as handed back by Probe.
+struct TTEntry
+{
+	uint64_t		key;
+	int				score;
+	short			depth;
+	unsigned char	bound;
+	unsigned char	age;
+	Move			bestMove;			//No move when there is none.
+
+	bool HasBestMove() const			{ return !bestMove.IsNone(); }
+	Move GetBestMove() const			{ return bestMove; }
+};
+
+//--------------------------------------------------------------------------------------------------
+
+//Shared by every search thread without locks. Each entry is two 64-bit words, the key xor'd with
+//the data and the data itself. A torn write from two threads storing at once fails the key check
+//on the next probe, so it reads as a miss rather than a wrong result.
+class TranspositionTable
+{
+//--------------------------------------------------------------------------------------------------
+public:
+	TranspositionTable(size_t megabytes);
+
+	void Resize(size_t megabytes);
+	void Clear();
+	void NewSearch();
+
+	bool Probe(uint64_t key, TTEntry* entry) const;
+	void Store(uint64_t key, int depth, TT_BOUND bound, int score, const Move* bestMove);
+
+	//Mate scores are stored relative to the node, not the root, so they stay valid wherever the position is reached.
+	static int ScoreToTable(int score, int ply);
+	static int ScoreFromTable(int score, int ply);
+
+//--------------------------------------------------------------------------------------------------
+private:
+	struct TTSlot
+	{
+		atomic<uint64_t> check;		//key ^ data.
+		atomic<uint64_t> data;		//Score, depth, bound, age and the packed best move together.
+	};
+
+	//Two entries share each bucket. The first keeps the deepest result of the current search, the
+	//second always takes the newest, so shallow results never push out expensive ones.
+	struct TTBucket
+	{
+		TTSlot depthPreferred;
+		TTSlot alwaysReplace;
+	};
+
+	bool ReadSlot(const TTSlot& slot, uint64_t key, TTEntry* entry) const;
+
+	unique_ptr<TTBucket[]> mBuckets;
+	size_t				   mBucketCount;
+	uint64_t			   mIndexMask;
+	unsigned char		   mAge;
+};
+
+//--------------------------------------------------------------------------------------------------
+
+#endif //_CHESS_TRANSPOSITIONTABLE_H
@@ -48,7 +48,7 @@ GameScreen_Chess::GameScreen_Chess(sdl_game::app_context & context)
 	mGameStateSpritesheet = context.load_texture(kChessGameStatesPath, texture_filtering_nearest);
 
 	//Start values.
-	mLastMove				= new Move(SDL_Point(999,999), SDL_Point(999,999));
+	mLastMove				= new Move();
 	mSearchDepth			= new int;
 	*mSearchDepth			= kSearchDepth;
 	mSelectedPiecePosition  = SDL_Point();
@@ -77,6 +77,9 @@ GameScreen_Chess::~GameScreen_Chess()
 
 	delete mSearchDepth;
 	mSearchDepth = NULL;
+
+	//Let the last moves and the result reach the console before the game goes.
+	MoveManager::Shutdown();
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -107,12 +110,23 @@ void GameScreen_Chess::Update(float deltaTime, SDL_Event e)
 
 				case SDLK_UP:
 					*mSearchDepth += 1;
-					cout << endl << "Search Depth = " << *mSearchDepth << endl;
+					MoveManager::Instance()->OutputText("\nSearch Depth = " + to_string(*mSearchDepth) + "\n");
+
+					//Any search in progress was for the old depth. A human's half made move is left alone.
+					if(mTurnState == TURNSTATE_PLAY)
+						mPlayers[mPlayerTurn]->SearchDepthChanged();
 				break;
 
 				case SDLK_DOWN:
 					*mSearchDepth = max(1, *mSearchDepth-1);
-					cout << endl << "Search Depth = " << *mSearchDepth << endl;
+					MoveManager::Instance()->OutputText("\nSearch Depth = " + to_string(*mSearchDepth) + "\n");
+
+					if(mTurnState == TURNSTATE_PLAY)
+						mPlayers[mPlayerTurn]->SearchDepthChanged();
+				break;
+
+				case SDLK_r:
+					ResetGame();
 				break;
 			}
 		break;
@@ -168,6 +182,25 @@ void GameScreen_Chess::Update(float deltaTime, SDL_Event e)
 
 //--------------------------------------------------------------------------------------------------
 
+void GameScreen_Chess::ResetGame()
+{
+	//Stop anyone still thinking before the board changes under them.
+	mPlayers[COLOUR_WHITE]->CancelTurn();
+	mPlayers[COLOUR_BLACK]->CancelTurn();
+
+	*mChessBoard			= Board();
+	*mLastMove				= Move();
+	mSelectedPiecePosition	= SDL_Point();
+	mHighlightPositions.clear();
+	mPlayerTurn				= COLOUR_WHITE;
+	mTurnState				= TURNSTATE_PRE;
+
+	//Also announces the new game, in turn with the moves still being written out.
+	MoveManager::Instance()->ClearRecordedMoves();
+}
+
+//--------------------------------------------------------------------------------------------------
+
 void GameScreen_Chess::RenderBoard(sdl_game::app_context & context)
 {
 	//Draw the black and white board.
@@ -188,7 +221,7 @@ void GameScreen_Chess::RenderBoard(sdl_game::app_context & context)
 	{
 		SDL_Rect destRect = {(int)mSelectedPiecePosition.x*kChessPieceDimensions, (int)mSelectedPiecePosition.y*kChessPieceDimensions, kChessPieceDimensions, kChessPieceDimensions};
 		SDL_Rect portionOfSpritesheet = {0, 0, kChessPieceDimensions, kChessPieceDimensions};
-		portionOfSpritesheet.y = mChessBoard->currentLayout[(int)mSelectedPiecePosition.x][(int)mSelectedPiecePosition.y].piece * kChessPieceDimensions;
+		portionOfSpritesheet.y = mChessBoard->currentLayout[(int)mSelectedPiecePosition.x][(int)mSelectedPiecePosition.y].Piece() * kChessPieceDimensions;
 
 		context.render_atlas(mSelectedPieceSpritesheet, sdl_game::to_fpoint({destRect.x, destRect.y}),
 		{
@@ -205,7 +238,7 @@ void GameScreen_Chess::RenderBoard(sdl_game::app_context & context)
 void GameScreen_Chess::RenderPiece(sdl_game::app_context & context, BoardPiece boardPiece, SDL_Point position)
 {
 	std::shared_ptr<SDL_Texture> spritesheet;
-	switch(boardPiece.colour)
+	switch(boardPiece.Colour())
 	{
 		case COLOUR_WHITE:
 			spritesheet = mWhitePiecesSpritesheet;
@@ -225,7 +258,7 @@ void GameScreen_Chess::RenderPiece(sdl_game::app_context & context, BoardPiece b
 	};
 
 	SDL_Rect portionOfSpritesheet = {0, 0, kChessPieceDimensions, kChessPieceDimensions};
-	portionOfSpritesheet.y = boardPiece.piece * kChessPieceDimensions;
+	portionOfSpritesheet.y = boardPiece.Piece() * kChessPieceDimensions;
 
 	context.render_atlas(spritesheet, sdl_game::to_fpoint(position),
 	{
@@ -241,8 +274,8 @@ void GameScreen_Chess::RenderHighlights(sdl_game::app_context & context)
 	//Always highlight previous move, if there is one.
 	if(MoveManager::Instance()->HasRecordedMoves())
 	{
-		SDL_Rect destRectStart = {(int)MoveManager::Instance()->GetLastMove().from_X*kChessPieceDimensions, (int)MoveManager::Instance()->GetLastMove().from_Y*kChessPieceDimensions, kChessPieceDimensions, kChessPieceDimensions};
-		SDL_Rect destRectEnd   = {(int)MoveManager::Instance()->GetLastMove().to_X*kChessPieceDimensions, (int)MoveManager::Instance()->GetLastMove().to_Y*kChessPieceDimensions, kChessPieceDimensions, kChessPieceDimensions};
+		SDL_Rect destRectStart = {MoveManager::Instance()->GetLastMove().FromX()*kChessPieceDimensions, MoveManager::Instance()->GetLastMove().FromY()*kChessPieceDimensions, kChessPieceDimensions, kChessPieceDimensions};
+		SDL_Rect destRectEnd   = {MoveManager::Instance()->GetLastMove().ToX()*kChessPieceDimensions, MoveManager::Instance()->GetLastMove().ToY()*kChessPieceDimensions, kChessPieceDimensions, kChessPieceDimensions};
 		SDL_Rect portionOfSpritesheet = {0, 0, kChessPieceDimensions, kChessPieceDimensions};
 
 		context.render_atlas(mPreviousMoveHighlightSpritesheet, sdl_game::to_fpoint({destRectStart.x, destRectStart.y}), {.region = portionOfSpritesheet});
@@ -287,17 +320,20 @@ void GameScreen_Chess::RenderPreTurnText(sdl_game::app_context & context)
 			.region = portionOfSpritesheet,
 		});
 
-		//Render last move in highlighted squares.
+		//Render last move in highlighted squares, once there is one.
+		if(mLastMove->IsNone())
+			return;
+
 		SDL_Rect portionOfHighlightSpritesheet = {0, 0, kChessPieceDimensions, kChessPieceDimensions};
 
-		SDL_Rect destRect_FromPosition = {mLastMove->from_X*kChessPieceDimensions, mLastMove->from_Y*kChessPieceDimensions, kChessPieceDimensions, kChessPieceDimensions};
+		SDL_Rect destRect_FromPosition = {mLastMove->FromX()*kChessPieceDimensions, mLastMove->FromY()*kChessPieceDimensions, kChessPieceDimensions, kChessPieceDimensions};
 
 		context.render_atlas(mSquareHighlightSpritesheet, sdl_game::to_fpoint({destRect_FromPosition.x, destRect_FromPosition.y}),
 		{
 			.region = portionOfHighlightSpritesheet,
 		});
 
-		SDL_Rect destRect_ToPosition = {mLastMove->to_X*kChessPieceDimensions, mLastMove->to_Y*kChessPieceDimensions, kChessPieceDimensions, kChessPieceDimensions};
+		SDL_Rect destRect_ToPosition = {mLastMove->ToX()*kChessPieceDimensions, mLastMove->ToY()*kChessPieceDimensions, kChessPieceDimensions, kChessPieceDimensions};
 
 		context.render_atlas(mSquareHighlightSpritesheet, sdl_game::to_fpoint({destRect_ToPosition.x, destRect_ToPosition.y}),
 		{
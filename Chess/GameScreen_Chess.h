@@ -22,6 +22,8 @@ public:
 
 //--------------------------------------------------------------------------------------------------
 private:
+	void ResetGame();
+
 	void RenderBoard(sdl_game::app_context & context);
 	void RenderPiece(sdl_game::app_context & context, BoardPiece boardPiece, SDL_Point position);
 	void RenderHighlights(sdl_game::app_context & context);
@@ -17,7 +17,14 @@ namespace
 
 		void on_event(sdl_game::app_context const & context, SDL_Event const & event)
 		{
-			_game_screen->Update(1.f / 60.f, event);
+			//Time only passes in on_update, so timers tick once a frame however busy the input is.
+			_game_screen->Update(0.f, event);
+		}
+
+		void on_update(sdl_game::app_context const & context)
+		{
+			//Keeps the turns moving between input events, e.g. to pick up the AI's move once it is ready.
+			_game_screen->Update(1.f / 60.f, SDL_Event{});
 		}
 
 		void on_render(sdl_game::app_context & context)
@@ -0,0 +1,170 @@
+//------------------------------------------------------------------------
+//  Headless perft - Counts the leaf nodes of the move generator's tree to
+//  prove it correct against known results, and times it while doing so.
+//
+//  perft                   Runs every reference position to its listed depth.
+//  perft <depth> [fen]     Counts each depth up to <depth>, then divides the
+//                          last one by root move. Defaults to the start position.
+//------------------------------------------------------------------------
+
+#include "ChessMoveGenerator.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+using namespace::std;
+
+//--------------------------------------------------------------------------------------------------
+
+namespace
+{
+	const string kStartPositionFen = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+	//Published node counts, indexed by depth - 1. Zero ends a list.
+	struct ReferencePosition
+	{
+		const char* name;
+		const char* fen;
+		uint64_t	nodes[6];
+	};
+
+	const ReferencePosition kReferencePositions[] =
+	{
+		{ "Start position",	"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",				{ 20, 400, 8902, 197281, 4865609, 0 } },
+		{ "Kiwipete",		"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",	{ 48, 2039, 97862, 4085603, 0, 0 } },
+		{ "Position 3",		"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",								{ 14, 191, 2812, 43238, 674624, 0 } },
+		{ "Position 4",		"r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",		{ 6, 264, 9467, 422333, 0, 0 } },
+		{ "Position 5",		"rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",				{ 44, 1486, 62379, 2103487, 0, 0 } },
+		{ "Position 6",		"r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",	{ 46, 2079, 89890, 3894594, 0, 0 } },
+	};
+
+	//----------------------------------------------------------------------------------------------
+
+	uint64_t Perft(Position* position, int depth)
+	{
+		MoveList moves;
+		GenerateMoves(*position, &moves);
+
+		//The last ply only needs counting, not playing.
+		if(depth == 1)
+			return moves.Size();
+
+		uint64_t nodes = 0;
+		for(const Move& move : moves)
+		{
+			position->MakeMove(move);
+			nodes += Perft(position, depth - 1);
+			position->UnMakeMove();
+		}
+
+		return nodes;
+	}
+
+	//----------------------------------------------------------------------------------------------
+
+	//Runs one depth and prints its count with the time taken and the nodes per second.
+	uint64_t TimedPerft(Position* position, int depth)
+	{
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		uint64_t nodes = Perft(position, depth);
+		double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+		cout << "  Depth " << depth << ": " << nodes << " nodes  " << (int)(seconds * 1000.0) << "ms  ";
+		cout << (seconds > 0.0 ? (uint64_t)(nodes / seconds) : 0) << " nps";
+		return nodes;
+	}
+
+	//----------------------------------------------------------------------------------------------
+
+	void Divide(Position* position, int depth)
+	{
+		MoveList moves;
+		GenerateMoves(*position, &moves);
+
+		uint64_t total = 0;
+		for(const Move& move : moves)
+		{
+			position->MakeMove(move);
+			uint64_t nodes = depth > 1 ? Perft(position, depth - 1) : 1;
+			position->UnMakeMove();
+
+			cout << MoveToString(move) << ": " << nodes << endl;
+			total += nodes;
+		}
+
+		cout << endl << "Moves: " << moves.Size() << "  Nodes: " << total << endl;
+	}
+
+	//----------------------------------------------------------------------------------------------
+
+	int RunReferenceSuite()
+	{
+		int failures = 0;
+
+		for(const ReferencePosition& reference : kReferencePositions)
+		{
+			Position position;
+			position.LoadFen(reference.fen);
+			cout << reference.name << "  " << reference.fen << endl;
+
+			for(int depth = 1; depth <= 6 && reference.nodes[depth - 1] != 0; depth++)
+			{
+				uint64_t nodes = TimedPerft(&position, depth);
+				if(nodes == reference.nodes[depth - 1])
+				{
+					cout << "  OK" << endl;
+				}
+				else
+				{
+					cout << "  FAILED - Expected " << reference.nodes[depth - 1] << endl;
+					failures++;
+				}
+			}
+			cout << endl;
+		}
+
+		cout << (failures == 0 ? "All positions passed." : "Some positions FAILED.") << endl;
+		return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+}
+
+//--------------------------------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+{
+	if(argc < 2)
+		return RunReferenceSuite();
+
+	int	   depth = atoi(argv[1]);
+	string fen	 = kStartPositionFen;
+
+	//A FEN is several words, so take everything after the depth.
+	if(argc > 2)
+	{
+		fen = argv[2];
+		for(int argument = 3; argument < argc; argument++)
+			fen += string(" ") + argv[argument];
+	}
+
+	Position position;
+	if(depth < 1 || !position.LoadFen(fen))
+	{
+		cout << "Usage: perft [depth [fen]]" << endl;
+		return EXIT_FAILURE;
+	}
+
+	cout << fen << endl;
+	for(int currentDepth = 1; currentDepth <= depth; currentDepth++)
+	{
+		TimedPerft(&position, currentDepth);
+		cout << endl;
+	}
+
+	cout << endl;
+	Divide(&position, depth);
+	return EXIT_SUCCESS;
+}
+
+//--------------------------------------------------------------------------------------------------
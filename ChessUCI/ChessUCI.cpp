@@ -0,0 +1,614 @@
+//------------------------------------------------------------------------
+//  Universal Chess Interface front-end - Drives the engine from stdin so
+//  it can play under GUIs and tournament managers.
+//------------------------------------------------------------------------
+
+#include "ChessUCI.h"
+#include "ChessConstants.h"
+#include "ChessEPD.h"
+#include "ChessMoveGenerator.h"
+#include "ChessNotation.h"
+#include <algorithm>
+#include <iomanip>
+
+using namespace::std;
+
+//--------------------------------------------------------------------------------------------------
+
+const string	   kEngineName			= "AdvancedAI Chess";
+const string	   kEngineAuthor		= "Paul Roberts";
+const string	   kStartPositionFen	= "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+const int		   kMaxHashSizeMB		= 4096;
+const int		   kMaxThreads			= 256;
+
+const int		   kDefaultBenchDepth	= 7;
+const unsigned int kDefaultEPDTimeMS	= 1000;		//Per position, when "epd" isn't given a depth or time.
+
+//Fixed positions searched by "bench", so node counts can be compared from one build to the next.
+//Openings, middlegames with both kings castled and not, and endgames where zugzwang is common.
+const string	   kBenchPositions[]	=
+{
+	"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+	"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+	"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+	"r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+	"rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+	"r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+	"r1bqkb1r/pppp1ppp/2n2n2/4p3/2B1P3/5N2/PPPP1PPP/RNBQK2R w KQkq - 4 4",
+	"r2q1rk1/pp2bppp/2n1pn2/3p4/2PP4/2N1PN2/PP2BPPP/R2Q1RK1 w - - 0 9",
+	"6k1/5ppp/8/8/8/8/5PPP/3R2K1 w - - 0 1",
+	"8/8/4k3/3p4/3P4/4K3/8/8 w - - 0 1",
+	"8/5pk1/6p1/7p/7P/6P1/5PK1/8 w - - 0 1",
+	"8/8/1p6/1P1k4/8/2K5/8/8 w - - 0 1"
+};
+
+const int		   kDefaultMovesToGo	= 30;		//Moves the remaining clock is shared over when the GUI doesn't say.
+const int		   kMoveOverheadMS		= 50;		//Kept back from every move for the GUI and the pipe.
+
+//--------------------------------------------------------------------------------------------------
+
+UCIEngine::UCIEngine()
+	: mSearchManager(kTranspositionTableSizeMB, 1)
+{
+	mStopRequested = false;
+	mPosition.LoadFen(kStartPositionFen);
+
+	mSearchManager.SetReporter([this](const SearchInfo& info) { ReportInfo(info); });
+}
+
+//--------------------------------------------------------------------------------------------------
+
+UCIEngine::~UCIEngine()
+{
+	CommandStop();
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void UCIEngine::Run(istream& input)
+{
+	string line;
+	while (getline(input, line))
+	{
+		if (!HandleCommand(line))
+			break;
+	}
+}
+
+//--------------------------------------------------------------------------------------------------
+
+bool UCIEngine::HandleCommand(const string& line)
+{
+	istringstream arguments(line);
+	string		  command;
+	arguments >> command;
+
+	if (command == "uci")
+	{
+		CommandUCI();
+	}
+	else if (command == "isready")
+	{
+		Send("readyok");
+	}
+	else if (command == "ucinewgame")
+	{
+		CommandStop();
+		mSearchManager.ClearHash();
+	}
+	else if (command == "setoption")
+	{
+		CommandSetOption(arguments);
+	}
+	else if (command == "position")
+	{
+		CommandPosition(arguments);
+	}
+	else if (command == "go")
+	{
+		CommandGo(arguments);
+	}
+	else if (command == "stop")
+	{
+		CommandStop();
+	}
+	else if (command == "bench")
+	{
+		CommandBench(arguments);
+	}
+	else if (command == "pruningbench")
+	{
+		CommandPruningBench(arguments);
+	}
+	else if (command == "epd")
+	{
+		CommandEPD(arguments);
+	}
+	else if (command == "quit")
+	{
+		CommandStop();
+		return false;
+	}
+
+	//Anything else, ponderhit and debug included, is ignored.
+	return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void UCIEngine::CommandUCI()
+{
+	Send("id name " + kEngineName);
+	Send("id author " + kEngineAuthor);
+	Send("option name Hash type spin default " + to_string(kTranspositionTableSizeMB) + " min 1 max " + to_string(kMaxHashSizeMB));
+	Send("option name Threads type spin default 1 min 1 max " + to_string(kMaxThreads));
+	Send("option name Pruning type combo default " + PruningPolicy::ModeToString(PRUNING_FUTILITY) + " var Off var Beam var Futility");
+	Send("option name BeamWidth type spin default " + to_string(kMaxMovesPerPly) + " min 1 max " + to_string(kMaxMovesPerPosition));
+	Send("option name SyzygyPath type string default <empty>");
+	Send("option name SyzygyProbeLimit type spin default " + to_string(kTablebaseMaxPieces) + " min 0 max " + to_string(kTablebaseMaxPieces));
+	Send("uciok");
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void UCIEngine::CommandSetOption(istringstream& arguments)
+{
+	//setoption name <name> value <value> - Names and values may hold spaces.
+	string token;
+	string name;
+	string value;
+	arguments >> token;
+
+	while (arguments >> token && token != "value")
+	{
+		name += (name.empty() ? "" : " ") + token;
+	}
+	getline(arguments >> ws, value);
+
+	int number = atoi(value.c_str());
+	if (name == "Hash")
+	{
+		CommandStop();
+		mSearchManager.SetHashSize(clamp(number, 1, kMaxHashSizeMB));
+	}
+	else if (name == "Threads")
+	{
+		CommandStop();
+		mSearchManager.SetThreadCount(clamp(number, 1, kMaxThreads));
+	}
+	else if (name == "Pruning")
+	{
+		CommandStop();
+
+		PRUNING_MODE mode;
+		if (PruningPolicy::ModeFromString(value, &mode))
+		{
+			mSearchManager.SetPruningPolicy(PruningPolicy(mode, mSearchManager.GetPruningPolicy().GetBeamWidth()));
+		}
+		else
+		{
+			Send("info string Unknown pruning " + value);
+		}
+	}
+	else if (name == "BeamWidth")
+	{
+		CommandStop();
+		mSearchManager.SetPruningPolicy(PruningPolicy(mSearchManager.GetPruningPolicy().GetMode(), clamp(number, 1, kMaxMovesPerPosition)));
+	}
+	else if (name == "SyzygyPath")
+	{
+		CommandStop();
+		mSearchManager.SetTablebasePath(value == "<empty>" ? "" : value);
+
+		const Tablebases* tablebases = mSearchManager.GetTablebases();
+		Send("info string Found " + to_string(tablebases->GetTableCount()) + " tablebase files, up to " + to_string(tablebases->GetLargestTable()) + " pieces");
+	}
+	else if (name == "SyzygyProbeLimit")
+	{
+		CommandStop();
+		mSearchManager.SetTablebasePieceLimit(clamp(number, 0, kTablebaseMaxPieces));
+	}
+	else
+	{
+		Send("info string Unknown option " + name);
+	}
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void UCIEngine::CommandPosition(istringstream& arguments)
+{
+	//position [startpos | fen <fen>] [moves <move> ...]
+	string token;
+	string fen;
+	arguments >> token;
+
+	if (token == "startpos")
+	{
+		fen = kStartPositionFen;
+		arguments >> token;
+	}
+	else if (token == "fen")
+	{
+		while (arguments >> token && token != "moves")
+		{
+			fen += (fen.empty() ? "" : " ") + token;
+		}
+	}
+
+	if (!mPosition.LoadFen(fen))
+	{
+		Send("info string Invalid position " + fen);
+		mPosition.LoadFen(kStartPositionFen);
+		return;
+	}
+
+	if (token != "moves")
+		return;
+
+	//Moves arrive in coordinate notation, so match each against the legal moves' text.
+	while (arguments >> token)
+	{
+		MoveList moves;
+		GenerateMoves(mPosition, &moves);
+
+		const Move* matchingMove = nullptr;
+		for (const Move& move : moves)
+		{
+			if (MoveToString(move) == token)
+			{
+				matchingMove = &move;
+				break;
+			}
+		}
+
+		if (matchingMove == nullptr)
+		{
+			Send("info string Illegal move " + token);
+			return;
+		}
+
+		mPosition.MakeMove(*matchingMove);
+	}
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void UCIEngine::CommandGo(istringstream& arguments)
+{
+	CommandStop();
+
+	SearchLimits limits;
+	int	 whiteTimeMS	  = -1;
+	int	 blackTimeMS	  = -1;
+	int	 whiteIncrementMS = 0;
+	int	 blackIncrementMS = 0;
+	int	 movesToGo		  = 0;
+	bool infinite		  = false;
+
+	string token;
+	while (arguments >> token)
+	{
+		if (token == "depth")			arguments >> limits.depth;
+		else if (token == "movetime")	arguments >> limits.timeLimitMS;
+		else if (token == "nodes")		arguments >> limits.nodeLimit;
+		else if (token == "wtime")		arguments >> whiteTimeMS;
+		else if (token == "btime")		arguments >> blackTimeMS;
+		else if (token == "winc")		arguments >> whiteIncrementMS;
+		else if (token == "binc")		arguments >> blackIncrementMS;
+		else if (token == "movestogo")	arguments >> movesToGo;
+		else if (token == "infinite")	infinite = true;
+	}
+
+	limits.depth = clamp(limits.depth, 1, kMaxSearchPly - 1);
+
+	//A fixed move time wins over the clock.
+	int timeLeftMS = mPosition.sideToMove == COLOUR_WHITE ? whiteTimeMS : blackTimeMS;
+	if (limits.timeLimitMS == 0 && timeLeftMS >= 0)
+	{
+		int incrementMS	   = mPosition.sideToMove == COLOUR_WHITE ? whiteIncrementMS : blackIncrementMS;
+		limits.timeLimitMS = AllocateTime(timeLeftMS, incrementMS, movesToGo);
+	}
+
+	//Nothing to search - Answer straight away rather than hand back an empty move.
+	if (!HasAnyLegalMove(mPosition))
+	{
+		Send(IsInCheck(mPosition, mPosition.sideToMove) ? "info depth 0 score mate 0" : "info depth 0 score cp 0");
+		Send("bestmove 0000");
+		return;
+	}
+
+	mStopRequested = false;
+	future<SearchResult> pendingMove = mSearchManager.StartSearch(mPosition, limits);
+
+	mBestMoveThread = thread([this, infinite, pendingMove = std::move(pendingMove)]() mutable
+	{
+		SearchResult result = pendingMove.get();
+
+		if (infinite)
+		{
+			unique_lock<mutex> lock(mStopMutex);
+			mStopCondition.wait(lock, [this]() { return mStopRequested; });
+		}
+
+		Send("bestmove " + MoveToString(result.bestMove));
+	});
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void UCIEngine::CommandStop()
+{
+	{
+		lock_guard<mutex> lock(mStopMutex);
+		mStopRequested = true;
+	}
+	mStopCondition.notify_all();
+
+	mSearchManager.Stop();
+	if (mBestMoveThread.joinable())
+	{
+		mBestMoveThread.join();
+	}
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void UCIEngine::CommandBench(istringstream& arguments)
+{
+	//bench [depth] - Not part of the protocol. Searches every bench position from an empty hash and
+	//totals the nodes, which only change when the search itself does.
+	CommandStop();
+
+	SearchLimits limits;
+	limits.depth = kDefaultBenchDepth;
+	arguments >> limits.depth;
+	limits.depth = clamp(limits.depth, 1, kMaxSearchPly - 1);
+
+	uint64_t  totalNodes = 0;
+	long long totalMS	 = 0;
+	for (const string& fen : kBenchPositions)
+	{
+		Position position;
+		position.LoadFen(fen);
+		Send("info string " + fen);
+
+		mSearchManager.ClearHash();
+		auto startTime = chrono::steady_clock::now();
+
+		Move bestMove;
+		mSearchManager.Search(position, limits, &bestMove);
+
+		totalMS	   += chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - startTime).count();
+		totalNodes += mSearchManager.GetNodesSearched();
+	}
+
+	mSearchManager.ClearHash();
+
+	Send("info string bench depth " + to_string(limits.depth) + " nodes " + to_string(totalNodes) + " time " + to_string(totalMS) +
+		 " nps " + to_string(totalNodes * 1000 / max(totalMS, 1LL)));
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void UCIEngine::CommandPruningBench(istringstream& arguments)
+{
+	//pruningbench [depth] - Not part of the protocol. Searches every bench position with each pruning
+	//mode, and measures what the pruning costs against the full width search's move and score.
+	CommandStop();
+
+	SearchLimits limits;
+	limits.depth = kDefaultBenchDepth;
+	arguments >> limits.depth;
+	limits.depth = clamp(limits.depth, 1, kMaxSearchPly - 1);
+
+	struct ModeTotals
+	{
+		uint64_t	 nodes		  = 0;
+		long long	 timeMS		  = 0;
+		int			 movesAgreed  = 0;
+		long long	 scoreError	  = 0;		//Centipawns away from the full width score, summed.
+		PruningStats pruning;
+	};
+
+	const PRUNING_MODE kModes[] = { PRUNING_OFF, PRUNING_BEAM, PRUNING_FUTILITY };
+	ModeTotals		   totals[size(kModes)];
+
+	//Thirty odd searches' worth of info lines would bury the results.
+	PruningPolicy originalPolicy = mSearchManager.GetPruningPolicy();
+	mSearchManager.SetReporter([](const SearchInfo&) {});
+
+	int positionCount = 0;
+	for (const string& fen : kBenchPositions)
+	{
+		Position position;
+		position.LoadFen(fen);
+		positionCount++;
+
+		Move referenceMove;
+		int	 referenceScore = 0;
+		for (size_t index = 0; index < size(kModes); index++)
+		{
+			mSearchManager.SetPruningPolicy(PruningPolicy(kModes[index], originalPolicy.GetBeamWidth()));
+			mSearchManager.ClearHash();
+			auto startTime = chrono::steady_clock::now();
+
+			Move bestMove;
+			int	 score = mSearchManager.Search(position, limits, &bestMove);
+
+			ModeTotals& modeTotals = totals[index];
+			modeTotals.timeMS += chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - startTime).count();
+			modeTotals.nodes  += mSearchManager.GetNodesSearched();
+			modeTotals.pruning.Add(mSearchManager.GetPruningStats());
+
+			//Full width comes first, and is what the others are measured against.
+			if (kModes[index] == PRUNING_OFF)
+			{
+				referenceMove  = bestMove;
+				referenceScore = score;
+			}
+			if (bestMove == referenceMove)
+			{
+				modeTotals.movesAgreed++;
+			}
+			modeTotals.scoreError += abs(ScoreToCentipawns(score) - ScoreToCentipawns(referenceScore));
+		}
+	}
+
+	mSearchManager.SetPruningPolicy(originalPolicy);
+	mSearchManager.SetReporter([this](const SearchInfo& info) { ReportInfo(info); });
+	mSearchManager.ClearHash();
+
+	uint64_t referenceNodes = max(totals[0].nodes, (uint64_t)1);
+	for (size_t index = 0; index < size(kModes); index++)
+	{
+		const ModeTotals& modeTotals = totals[index];
+
+		ostringstream line;
+		line << "info string " << PruningPolicy::ModeToString(kModes[index]) << " depth " << limits.depth;
+		line << " nodes " << modeTotals.nodes << " (" << modeTotals.nodes * 100 / referenceNodes << "%)";
+		line << " time " << modeTotals.timeMS;
+		line << " pruned beam " << modeTotals.pruning.beamPruned << " futility " << modeTotals.pruning.futilityPruned << " latemove " << modeTotals.pruning.lateMovesPruned;
+		line << " reduced " << modeTotals.pruning.reducedMoves << " researched " << modeTotals.pruning.reducedResearches;
+		line << " nullcutoffs " << modeTotals.pruning.nullMoveCutoffs;
+		line << " samemove " << modeTotals.movesAgreed << "/" << positionCount;
+		line << " meanerror " << modeTotals.scoreError / positionCount << "cp";
+		Send(line.str());
+	}
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void UCIEngine::CommandEPD(istringstream& arguments)
+{
+	//epd <file> [depth <plies> | movetime <ms>] - Not part of the protocol. Searches every position
+	//of a test suite such as WAC or STS from an empty hash, and counts those it solves.
+	CommandStop();
+
+	string path;
+	arguments >> path;
+
+	SearchLimits limits;
+	limits.timeLimitMS = kDefaultEPDTimeMS;
+
+	string token;
+	while (arguments >> token)
+	{
+		if (token == "depth")
+		{
+			arguments >> limits.depth;
+			limits.timeLimitMS = 0;
+		}
+		else if (token == "movetime")
+		{
+			arguments >> limits.timeLimitMS;
+		}
+	}
+	limits.depth = clamp(limits.depth, 1, kMaxSearchPly - 1);
+
+	vector<EPDRecord> records;
+	int				  skippedLines = 0;
+	if (!LoadEPDFile(path, &records, &skippedLines))
+	{
+		Send("info string Can't read " + path);
+		return;
+	}
+	if (skippedLines > 0)
+	{
+		Send("info string Skipped " + to_string(skippedLines) + " lines that don't parse");
+	}
+
+	//Only the verdict on each position is wanted, not every iteration.
+	mSearchManager.SetReporter([](const SearchInfo&) {});
+
+	int		  solvedCount = 0;
+	uint64_t  totalNodes  = 0;
+	long long totalMS	  = 0;
+	for (const EPDRecord& record : records)
+	{
+		Position position;
+		position.LoadFen(record.fen);
+		if (!HasAnyLegalMove(position))
+		{
+			continue;
+		}
+
+		mSearchManager.ClearHash();
+		auto startTime = chrono::steady_clock::now();
+
+		Move bestMove;
+		mSearchManager.Search(position, limits, &bestMove);
+
+		totalMS	   += chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - startTime).count();
+		totalNodes += mSearchManager.GetNodesSearched();
+
+		bool solved = record.IsSolvedBy(bestMove);
+		if (solved)
+		{
+			solvedCount++;
+		}
+		Send("info string " + (record.id.empty() ? record.fen : record.id) + (solved ? " solved " : " failed ") + MoveToSAN(position, bestMove));
+	}
+
+	mSearchManager.SetReporter([this](const SearchInfo& info) { ReportInfo(info); });
+	mSearchManager.ClearHash();
+
+	ostringstream line;
+	line << "info string epd solved " << solvedCount << "/" << records.size() << " time " << totalMS << " nodes " << totalNodes;
+	line << " solvedpersecond " << fixed << setprecision(2) << solvedCount * 1000.0 / max(totalMS, 1LL);
+	Send(line.str());
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void UCIEngine::ReportInfo(const SearchInfo& info)
+{
+	ostringstream line;
+	line << "info depth " << info.depth;
+
+	//Mate scores count moves, not plies, and are negative when it is us being mated.
+	if (info.score > kMateThreshold)
+		line << " score mate " << (kMateScore - info.score + 1) / 2;
+	else if (info.score < -kMateThreshold)
+		line << " score mate " << -(kMateScore + info.score) / 2;
+	else
+		line << " score cp " << ScoreToCentipawns(info.score);
+
+	line << " nodes " << info.nodes;
+	line << " nps " << info.nodes * 1000 / max(info.timeMS, 1LL);
+	line << " time " << info.timeMS;
+
+	line << " pv";
+	for (const Move& move : info.principalVariation)
+	{
+		line << " " << MoveToString(move);
+	}
+
+	Send(line.str());
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void UCIEngine::Send(const string& text)
+{
+	lock_guard<mutex> lock(mOutputMutex);
+	cout << text << endl;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+unsigned int UCIEngine::AllocateTime(int timeLeftMS, int incrementMS, int movesToGo)
+{
+	if (movesToGo <= 0)
+		movesToGo = kDefaultMovesToGo;
+
+	//An even share of what is left, plus most of the increment, but never more than the clock holds.
+	int budgetMS = timeLeftMS / movesToGo + incrementMS * 3 / 4;
+	budgetMS	 = min(budgetMS, timeLeftMS - kMoveOverheadMS);
+
+	//0 would mean no limit at all.
+	return (unsigned int)max(budgetMS, 1);
+}
+
+//--------------------------------------------------------------------------------------------------
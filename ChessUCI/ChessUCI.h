@@ -0,0 +1,67 @@
+//------------------------------------------------------------------------
+//  Universal Chess Interface front-end - Drives the engine from stdin so
+//  it can play under GUIs and tournament managers.
+//------------------------------------------------------------------------
+
+#ifndef _CHESS_UCI_H
+#define _CHESS_UCI_H
+
+#include "ChessPosition.h"
+#include "ChessSearch.h"
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+using namespace std;
+
+//--------------------------------------------------------------------------------------------------
+
+class UCIEngine
+{
+//--------------------------------------------------------------------------------------------------
+public:
+	UCIEngine();
+	~UCIEngine();
+
+	//Reads commands until "quit" or the end of input.
+	void Run(istream& input);
+
+//--------------------------------------------------------------------------------------------------
+private:
+	bool HandleCommand(const string& line);
+
+	void CommandUCI();
+	void CommandSetOption(istringstream& arguments);
+	void CommandPosition(istringstream& arguments);
+	void CommandGo(istringstream& arguments);
+	void CommandStop();
+	void CommandBench(istringstream& arguments);
+	void CommandPruningBench(istringstream& arguments);
+	void CommandEPD(istringstream& arguments);
+
+	void ReportInfo(const SearchInfo& info);
+	void Send(const string& text);
+
+	//Share of the clock to spend on this move.
+	unsigned int AllocateTime(int timeLeftMS, int incrementMS, int movesToGo);
+
+//--------------------------------------------------------------------------------------------------
+private:
+	SearchManager	   mSearchManager;
+	Position		   mPosition;
+
+	//Waits for the search to finish and sends bestmove. An infinite search holds its bestmove
+	//back until stop arrives, as the protocol requires.
+	thread			   mBestMoveThread;
+	mutex			   mStopMutex;
+	condition_variable mStopCondition;
+	bool			   mStopRequested;
+
+	mutex			   mOutputMutex;		//The search thread writes info lines while this one answers commands.
+};
+
+//--------------------------------------------------------------------------------------------------
+
+#endif //_CHESS_UCI_H
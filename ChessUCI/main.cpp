@@ -0,0 +1,17 @@
+//------------------------------------------------------------------------
+//  Console chess engine speaking the Universal Chess Interface.
+//------------------------------------------------------------------------
+
+#include "ChessUCI.h"
+
+//--------------------------------------------------------------------------------------------------
+
+int main()
+{
+	UCIEngine engine;
+	engine.Run(cin);
+
+	return 0;
+}
+
+//--------------------------------------------------------------------------------------------------
@@ -48,6 +48,37 @@ pub fn build(b: *std.Build) void {
     lib.linkSystemLibrary("SDL2_ttf");
     b.installArtifact(lib);
 
+    // Rules, move generation, evaluation and search. Nothing here touches SDL, so the engine
+    // builds and runs on machines without a display.
+    const chess_engine = b.addStaticLibrary(.{
+        .name = "chess-engine",
+        .target = target,
+        .optimize = optimize,
+    });
+
+    chess_engine.addCSourceFiles(.{
+        .flags = &.{ "--std=c++20", "-Werror" },
+        .root = b.path("Chess/"),
+
+        .files = &.{
+            "ChessBitboard.cpp",
+            "ChessEPD.cpp",
+            "ChessMappedFile.cpp",
+            "ChessMoveGenerator.cpp",
+            "ChessMovePicker.cpp",
+            "ChessNotation.cpp",
+            "ChessOpeningBook.cpp",
+            "ChessPosition.cpp",
+            "ChessPruningPolicy.cpp",
+            "ChessSearch.cpp",
+            "ChessTablebases.cpp",
+            "ChessTranspositionTable.cpp",
+        },
+    });
+
+    chess_engine.linkLibCpp();
+    b.installArtifact(chess_engine);
+
     const forester_game = add_game(b, &.{lib}, .{
         .name = "forester",
         .target = target,
@@ -69,7 +100,7 @@ pub fn build(b: *std.Build) void {
 
     b.installArtifact(forester_game);
 
-    const chess_game = add_game(b, &.{lib}, .{
+    const chess_game = add_game(b, &.{ lib, chess_engine }, .{
         .name = "chess",
         .target = target,
         .optimize = optimize,
@@ -90,6 +121,57 @@ pub fn build(b: *std.Build) void {
 
     b.installArtifact(chess_game);
 
+    const chess_perft = b.addExecutable(.{
+        .name = "perft",
+        .target = target,
+        .optimize = optimize,
+    });
+
+    chess_perft.linkLibCpp();
+    chess_perft.addIncludePath(b.path("Chess/"));
+    chess_perft.linkLibrary(chess_engine);
+
+    chess_perft.addCSourceFiles(.{
+        .flags = &.{ "--std=c++20", "-Werror" },
+        .root = b.path("ChessPerft/"),
+
+        .files = &.{
+            "main.cpp",
+        },
+    });
+
+    b.installArtifact(chess_perft);
+
+    const run_perft = b.addRunArtifact(chess_perft);
+
+    if (b.args) |args| {
+        run_perft.addArgs(args);
+    }
+
+    b.step("perft", "Check the chess move generator against reference perft counts").dependOn(&run_perft.step);
+
+    const chess_uci = b.addExecutable(.{
+        .name = "chess-uci",
+        .target = target,
+        .optimize = optimize,
+    });
+
+    chess_uci.linkLibCpp();
+    chess_uci.addIncludePath(b.path("Chess/"));
+    chess_uci.linkLibrary(chess_engine);
+
+    chess_uci.addCSourceFiles(.{
+        .flags = &.{ "--std=c++20", "-Werror" },
+        .root = b.path("ChessUCI/"),
+
+        .files = &.{
+            "ChessUCI.cpp",
+            "main.cpp",
+        },
+    });
+
+    b.installArtifact(chess_uci);
+
     const laser_wars_game = add_game(b, &.{lib}, .{
         .name = "zombies",
         .target = target,